@@ -27,7 +27,11 @@
 
 
 #include "ccnsim.h"
+#include "perfile_counters.h" //<aa>
+#include "content_index.h" //<aa>
 class DecisionPolicy;
+class statistics; //<aa>
+class content_sketch; //<aa>
 
 
 
@@ -36,12 +40,6 @@ class DecisionPolicy;
 //-) data_store: stores chunks within the cache with a given policy
 //-) data_lookup: return if the given chunk exists within the cache
 //
-struct cache_stat_entry{
-    unsigned int  miss; //Total number of misses
-    unsigned int  hit; //Totatle number of hit
-    cache_stat_entry():miss(0),hit(0){;}
-    double rate(){ return hit *1./(hit+miss);} //return the miss rate of the class
-};
 
 class base_cache : public abstract_node{
     friend class statistics;
@@ -56,6 +54,22 @@ class base_cache : public abstract_node{
 		virtual bool data_lookup(chunk_t) = 0;
 		virtual void dump(){cout<<"Not implemented"<<endl;}
 
+		//<aa> Tell the statistics module, once, that the cache became full </aa>
+		void check_full();
+
+		//<aa> To be called by the cache engines each time a chunk enters or
+		// leaves their lookup structure (see content_index.h) </aa>
+		void index_insert(chunk_t chunk){
+			if (content_index::enabled() ) content_index::insert(chunk, getIndex() );
+		}
+		void index_erase(chunk_t chunk){
+			if (content_index::enabled() ) content_index::erase(chunk, getIndex() );
+		}
+
+		//<aa> Output of the sketch statistics </aa>
+		void record_sketch();
+		double sketch_rate(name_t);
+
 		//<aa>
 		#ifdef SEVERE_DEBUG
 		bool initialized;
@@ -90,6 +104,11 @@ class base_cache : public abstract_node{
 
 		virtual bool full() = 0; //<aa> moved from protected to public</aa>
 
+		//<aa> Estimated heap memory of the lookup structures of the cache 
+		// engine, and of the statistics of the cache (see memory_footprint.h) </aa>
+		virtual size_t index_footprint(){ return 0; }
+		size_t stats_footprint();
+
     private:
 		int  cache_size;
 		int  nodes;
@@ -97,6 +116,11 @@ class base_cache : public abstract_node{
 
 		DecisionPolicy *decisor;
 
+		//<aa>
+		statistics *stats;
+		bool full_notified; // the statistics module already knows this cache is full
+		//</aa>
+
 		//Average statistics
 		uint32_t miss;
 		uint32_t hit;
@@ -108,7 +132,13 @@ class base_cache : public abstract_node{
 
 
 		//Per file statistics
-		cache_stat_entry *cache_stats;
+		//<aa> It was a cache_stat_entry array, reallocated at each clear_stat </aa>
+		enum {HIT_COUNTER, MISS_COUNTER};
+		perfile_counters<2> cache_stats;
+
+		//<aa> Approximate per content statistics over the whole catalog
+		// (NULL unless sketch_width > 0) </aa>
+		content_sketch *sketch;
 };
 
 #endif
@@ -67,22 +67,11 @@ public:
 	virtual name_t get_chunk_number(){return __chunk(chunk_var);}
 
 
-	virtual vector<int> get_repos()
+	//<aa> The returned view points to a list shared by all the contents with 
+	// the same placement: it is valid for the whole simulation </aa>
+	virtual repo_view get_repos()
 	{
-	    repo_t repo;
-	    vector<int> repos;
-	    int i;
-
-	    repo = __repo(__id(chunk_var));
-	    i = 0;
-
-	    while (repo)
-	    {
-			if (repo & 1) 
-				repos.push_back(content_distribution::repositories[i]);
-			repo >>= 1;
-			i++;
-	    }
+	    repo_view repos = content_distribution::repo_list( __repo(__id(chunk_var)) );
 
 		//<aa>
 		#ifdef SEVERE_DEBUG
@@ -14,6 +14,12 @@
 // This does not affect in any way the results.
 // #define SEVERE_DEBUG
 
+// If PROFILER is enabled, the events and the CPU cycles spent in the main
+// handlers are counted per node, and a report is printed at the end of the
+// simulation (see profiler.h). When it is not, the profiling code is not
+// even compiled.
+// #define PROFILER
+
 #define UNDEFINED_VALUE -1
 //</aa>
 
@@ -30,6 +36,16 @@
 #define FULL_CHECK 2000
 #define STABLE_CHECK 3000
 #define END 4000
+//<aa>
+#define BATCH_CHECK 3500
+#define TELEMETRY 3600
+#define LEVEL_SAMPLE 3700
+//</aa>
+
+//<aa>
+//Popularity drift timers
+#define DRIFT 5000
+//</aa>
 
 //Typedefs
 //Catalogs fields
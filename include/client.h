@@ -27,38 +27,34 @@
 
 #include <omnetpp.h>
 #include "ccnsim.h"
+//<aa>
+#include <queue>
+#include "trace_reader.h"
+#include "download_table.h"
+#include "hdr_histogram.h"
+#include "perfile_counters.h"
+#include "request_buffer.h"
+//</aa>
 class statistics;
+class rank_permutation; //<aa> See rank_permutation.h </aa>
 class ccn_data;
 using namespace std;
 
 
 
-//Each of these entries contains information about the current downloads
-struct download {
-    filesize_t chunk; //number of chunks that still miss within the file
+//<aa>
+//Entry of the deadline heap of a client: the download (name,id) times out at
+//deadline, unless a chunk has been received in the meanwhile
+struct download_deadline{
+    simtime_t deadline;
+    name_t name;
+    unsigned long id;
 
-    simtime_t start; //start time (for statistic purposes)
-    simtime_t last; //last time a chunk has been downloaded
-
-	//<aa>
-	#ifdef SEVERE_DEBUG
-		int serial_number;
-	#endif
-	//</aa>
-
-    download (double m = 0,simtime_t t = 0):chunk(m),start(t),last(t){;}
+    download_deadline(simtime_t d, name_t n, unsigned long i):deadline(d),name(n),id(i){;}
+    bool operator>(const download_deadline &other) const { return deadline > other.deadline; }
 };
+//</aa>
 
-//Each of these entries contains statistics for each single file
-struct client_stat_entry{
-    double avg_distance;
-    simtime_t avg_time;
-    double tot_downloads;//double type due to the chunkization in CCN. See below.
-    unsigned int tot_chunks; //<aa> The number of chunks downloaded so far </aa>
-
-    client_stat_entry():avg_distance(0),avg_time(0),tot_downloads(0),tot_chunks(0){;}
-
-};
 
 
 
@@ -69,9 +65,16 @@ class client : public cSimpleModule {
 		double get_tot_downloads();
 		simtime_t get_avg_time();
 		bool is_active();
-		void clear_stat(); //<aa> I moved this function to public</aa>
+		virtual void clear_stat(); //<aa> I moved this function to public</aa>
 		int  getNodeIndex(); //<aa> I moved it to public</aa>
 
+		//<aa>
+		const hdr_histogram &get_chunk_rtt_histogram(){ return chunk_rtt_histogram; }
+		const hdr_histogram &get_completion_histogram(){ return completion_histogram; }
+		unsigned int get_tot_chunks(){ return tot_chunks; }
+		size_t stats_footprint(){ return client_stats.memory_footprint(); }
+		//</aa>
+
 		//<aa>
 		#ifdef SEVERE_DEBUG
 		// Returns true iff the content is among the current_downloads
@@ -94,16 +97,54 @@ class client : public cSimpleModule {
 		void send_interest(name_t, cnumber_t, int);
 		void resend_interest(name_t,cnumber_t,int);
 
+		//<aa>
+		void start_download(name_t, cnumber_t);
+		void replay_trace();
+
+		void check_deadlines();
+		void schedule_timer();
+		download *find_download(const download_deadline &);
+		void fill_window(name_t, download &, int);
+
+		// Rate of the request process
+		virtual double arrival_rate();
+		double next_interarrival();
+		// Called when a download is completed
+		virtual void download_completed(const download &, simtime_t completion_time){;}
+
+		unsigned window_size(const download &);
+		void rtt_sample(download &, filesize_t);
+		void window_timeout(download &);
+		unsigned alloc_send_slot();
+		//</aa>
+
+		//<aa> User starting the next download (always 0, unless the requests 
+		// of several users are multiplexed, see population_client) </aa>
+		unsigned requesting_user;
+
 
     private:
 		cMessage *timer;
 		cMessage *arrival;
 
 		//List of current downloads for a given file
-		multimap < name_t, download > current_downloads;
+		download_table current_downloads; //<aa> It was a multimap<name_t, download> </aa>
+
+		//<aa> Timeouts of the current downloads, ordered by deadline. An entry
+		// is not removed when its download progresses: it is checked (and 
+		// possibly pushed back with the new deadline) when it reaches the top.
+		// The entries of completed downloads are dropped as soon as they reach
+		// the top, so that the timer is scheduled only when some download is
+		// pending
+		priority_queue< download_deadline, vector<download_deadline>, greater<download_deadline> > deadlines;
+		unsigned long next_download_id;
+		//</aa>
 
 		//Single file statistics
-		client_stat_entry* client_stats;
+		//<aa> It was a client_stat_entry array, reallocated at each clear_stat.
+		// The average distance of a file is its hop sum over its chunks </aa>
+		enum {HOPS_COUNTER, CHUNKS_COUNTER};
+		perfile_counters<2> client_stats;
 
 		//<aa> Number of objects downloaded by the client </aa>
 		double tot_downloads; // Here the "double" type arises when you consider
@@ -118,16 +159,60 @@ class client : public cSimpleModule {
 
 		//Average statistics (on the whole set of files downloaded by this client)
 		simtime_t avg_time;
+		//<aa> Chunks of the completed downloads and their total download time </aa>
+		double completed_chunks;
+		simtime_t completed_time;
+
+		//<aa> Distributions of the chunk RTT and of the download completion time </aa>
+		hdr_histogram chunk_rtt_histogram;
+		hdr_histogram completion_histogram;
 		double avg_distance;
 
 		//INI parameters
 		double lambda;
 		double RTT;
-		simtime_t check_time;
+		double check_time; //<aa> Period of the retransmissions of a download that timed out </aa>
+		unsigned W; //<aa> Interests in flight per download </aa>
+
+		//<aa> Congestion control
+		bool aimd; // Otherwise the window is fixed to W
+		double aimd_beta; // Multiplicative decrease
+		double raaqm_pmax; // Maximum probability of a delay-triggered decrease
+
+		// Send times of the chunks of the windows. Each download uses a slot
+		// of send_slot_size entries: chunk c is in the entry c % send_slot_size
+		vector<simtime_t> send_times;
+		vector<unsigned> free_send_slots;
+		unsigned send_slot_size;
+
+		// cwnd and RTT traces, recorded once every cc_trace_every samples
+		unsigned cc_trace_every;
+		unsigned cc_samples;
+		cOutVector cwnd_vector;
+		cOutVector rtt_vector;
+		//</aa>
 
 		//Set if the client actively sends interests for files
 		bool active;
 
+		//<aa> Draws of the request process, generated in blocks of
+		// request_block (0 to draw them one by one from the OMNeT++ RNG) </aa>
+		unsigned request_block;
+		request_buffer draws;
+
+		//<aa> Trace replay (NULL if requests are generated by the client)
+		trace_reader *trace;
+		unsigned trace_id;
+		trace_record next_record;
+		bool record_pending; // next_record must be replayed at the next arrival
+		simtime_t trace_start;
+		unsigned trace_skipped; // Number of invalid records
+
+		// Popularity ranking of the region of the client (NULL if the client
+		// uses the ranking of content_distribution)
+		rank_permutation *permutation;
+		//</aa>
+
 
 };
 #endif
@@ -27,6 +27,11 @@
 #include <omnetpp.h>
 #include "ccnsim.h"
 #include "zipf.h"
+//<aa>
+#include "shot_noise.h"
+#include "fenwick_tree.h"
+#include "popularity_drift.h" //<aa>
+//</aa>
 
 
 #pragma pack(push)
@@ -46,11 +51,31 @@ struct file{
 using namespace std;
 
 
+//<aa>
+// Non-owning view of an immutable list of repositories (see 
+// content_distribution::repo_list)
+class repo_view{
+    public:
+		typedef const int *const_iterator;
+
+		repo_view(const int *first_, const int *last_):first(first_),last(last_){;}
+		const_iterator begin() const {return first;}
+		const_iterator end() const {return last;}
+		unsigned size() const {return last - first;}
+		int operator[](unsigned i) const {return first[i];}
+
+    private:
+		const int *first;
+		const int *last;
+};
+//</aa>
+
 
 class content_distribution : public cSimpleModule{
     protected:
 		virtual void initialize();
 		void handleMessage(cMessage *){;}
+		~content_distribution(); //<aa>
 
 		//<aa>
 		//<aa>This method had no input parameters before</aa>
@@ -58,6 +83,7 @@ class content_distribution : public cSimpleModule{
 		virtual void initialize_repo_popularity();
 
 		virtual void finalize_total_replica();
+		void init_repo_lists();
 
 		#ifdef SEVERE_DEBUG
 		virtual void verify_replica_number();
@@ -80,6 +106,18 @@ class content_distribution : public cSimpleModule{
 
 		static vector<file> catalog;
 		static zipf_distribution zipf;
+		//<aa>
+		static shot_noise_distribution *snm; // NULL, unless request_model is "snm"
+		static drift_ranking *popularity; // Content of each rank (see popularity_drift.h).
+								// NULL, unless request_model is "drift"
+
+		// Return the name of the next requested object, given p uniformly
+		// distributed in [0,1)
+		static name_t draw_name(double p);
+
+		// Estimated heap memory of the catalog and of the repository lists
+		static size_t catalog_footprint();
+		//</aa>
 
 		static name_t perfile_bulk;
 		static name_t stabilization_bulk; 
@@ -91,6 +129,16 @@ class content_distribution : public cSimpleModule{
 		static double  *repo_prices; // repo_prices[i] is the price of the i-th repo
 		static int  *clients;
 
+		//<aa>
+		// Return the nodes the repositories of the placement repo are attached
+		// to. The lists are built once, after the content initialization, for
+		// the placements actually used by the catalog
+		static repo_view repo_list(repo_t repo){
+			const pair<unsigned,unsigned> &bounds = repo_list_bounds[repo];
+			return repo_view(&repo_lists[0] + bounds.first, &repo_lists[0] + bounds.second);
+		}
+		//</aa>
+
 		//<aa>
 		static int *total_replicas_p; // The number of replicas that are 
 								// distributed among all the repos
@@ -104,6 +152,9 @@ class content_distribution : public cSimpleModule{
 
     private:
 		//<aa>
+		static vector<int> repo_lists; // The lists of all the placements, one after the other
+		static vector< pair<unsigned,unsigned> > repo_list_bounds; // [begin,end) of each placement in repo_lists
+
 		vector<int> repo_strings; //It is a temporary variable used to generate content dispacement among repos
 		//</aa>
 		
@@ -0,0 +1,64 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef CONTENT_INDEX_H_
+#define CONTENT_INDEX_H_
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include "ccnsim.h"
+
+using namespace std;
+
+//<aa>
+// Global index from each chunk to the nodes whose cache holds it. It is
+// kept up to date by the cache engines, which report every chunk entering
+// or leaving their lookup structures (see base_cache::index_insert and
+// base_cache::index_erase), so that it answers exactly as fake_lookup would
+// on each node. Strategies exploring the caches (nrr) look up the holders of
+// a chunk instead of probing every cache in range.
+// The index is maintained only while some strategy subscribed to it.
+class content_index{
+    public:
+		static void subscribe();
+		// The last release empties the index
+		static void release();
+		static bool enabled(){ return users > 0; }
+
+		static void insert(chunk_t chunk, int node);
+		static void erase(chunk_t chunk, int node);
+
+		// Nodes holding the chunk, in no particular order (NULL if none)
+		static const vector<int> *holders(chunk_t chunk);
+
+		static size_t memory_footprint();
+
+    private:
+		// A chunk is usually held by few nodes: a small unsorted vector
+		// is the most compact set
+		static boost::unordered_map<chunk_t, vector<int> > index;
+		static unsigned users;
+};
+//</aa>
+#endif
@@ -0,0 +1,99 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef CONTENT_SKETCH_H_
+#define CONTENT_SKETCH_H_
+#include <stdint.h>
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include "ccnsim.h"
+
+using namespace std;
+
+//<aa>
+// Approximate per-content hit and miss counts over the whole catalog, at a
+// fixed memory cost (the per-file counters of base_cache stop at
+// __file_bulk). Two structures are kept:
+//	- a count-min sketch [cm] of depth rows of width counters, for hits and
+//	  for misses, with conservative update. The estimate of a content never
+//	  underestimates its count, and overestimates it by at most 
+//	  e*requests/width with probability 1-exp(-depth).
+//	- a Space-Saving summary [ss] of the top contents by number of requests.
+//	  The count of a monitored content overestimates its requests by at most
+//	  its error; hits are counted exactly while the content is monitored.
+//
+// With width 256, depth 4 and top 32 the whole structure takes about 9KB.
+struct sketch_top_entry{
+    name_t name;
+    uint32_t count; // requests, overestimated by at most error
+    uint32_t error;
+    uint32_t hits; // hits since the content is monitored
+};
+
+class content_sketch{
+    public:
+		// width is rounded up to a power of 2
+		content_sketch(unsigned width, unsigned depth, unsigned top);
+
+		void record(name_t name, bool hit);
+		void clear();
+
+		// Estimates of the hits and of the misses of a content
+		uint32_t hits(name_t name) const { return estimate(hit_counters, name); }
+		uint32_t misses(name_t name) const { return estimate(miss_counters, name); }
+
+		// Monitored contents, by decreasing number of requests
+		vector<sketch_top_entry> top() const;
+
+		size_t memory_footprint() const;
+
+    private:
+		unsigned column(unsigned row, name_t name) const {
+			return (unsigned) ( (seeds[row] * (uint64_t) name) >> shift);
+		}
+		uint32_t estimate(const vector<uint32_t> &counters, name_t name) const;
+		void update(vector<uint32_t> &counters, name_t name);
+
+		void sift_down(unsigned i);
+		void swap_entries(unsigned i, unsigned j);
+
+		unsigned width;
+		unsigned depth;
+		unsigned shift; // 64 - log2(width)
+		vector<uint64_t> seeds; // multiply-shift hash of each row
+		vector<uint32_t> hit_counters; // depth x width
+		vector<uint32_t> miss_counters;
+
+		//Space-Saving: min-heap on the count, and position of each content in it
+		unsigned top_size;
+		vector<sketch_top_entry> heap;
+		boost::unordered_map<name_t, unsigned> position;
+};
+//</aa>
+#endif
+
+// References
+// [cm] G. Cormode, S. Muthukrishnan, "An Improved Data Stream Summary: The Count-Min Sketch and its Applications", Journal of Algorithms, 2005
+// [ss] A. Metwally, D. Agrawal, A. El Abbadi, "Efficient Computation of Frequent and Top-k Elements in Data Streams", ICDT 2005
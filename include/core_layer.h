@@ -49,6 +49,14 @@ struct pit_entry {
     simtime_t time; //<aa> last time this entry has been updated</aa>
 };
 
+//<aa> Traffic sent through a face since the last clear_stat </aa>
+struct face_counters{
+    uint32_t interests;
+    uint32_t data;
+    uint64_t bytes;
+    face_counters():interests(0),data(0),bytes(0){;}
+};
+
 
 class core_layer : public abstract_node{
     friend class statistics;
@@ -56,8 +64,8 @@ class core_layer : public abstract_node{
     public:
     	void check_if_correct(int line);
 		//<aa>
-		#ifdef SEVERE_DEBUG
 		bool it_has_a_repo_attached;
+		#ifdef SEVERE_DEBUG
 
 		vector<int> get_interfaces_in_PIT(chunk_t chunk);
 		bool is_it_initialized;
@@ -65,6 +73,9 @@ class core_layer : public abstract_node{
 
 		double get_repo_price();
 		//void set_repo_price(double price);
+
+		// Estimated heap memory of the PIT (see memory_footprint.h)
+		size_t pit_footprint();
 		//</aa>
 
     protected:
@@ -114,8 +125,16 @@ class core_layer : public abstract_node{
 		int interests;
 		int data;
 
+		//<aa> Per face counters, and the sizes (in bytes) charged for each 
+		// packet sent </aa>
+		vector<face_counters> face_stats;
+		int interest_size;
+		int chunk_size;
+
 		//<aa>
-		#ifdef SEVERE_DEBUG
+		// The counters below used to exist only in SEVERE_DEBUG. They are
+		// always kept, so that check_if_correct can be run on a sample of the
+		// events (see check_every)
 		int unsolicited_data;	// Data received by the node but not requested by anyone
 
 		int discarded_interests; //number of incoming interests discarded
@@ -124,7 +143,9 @@ class core_layer : public abstract_node{
 									//in the cache nor in the repository of this node	
 		int interests_satisfied_by_cache;
 
-		#endif
+		unsigned check_every; // check_if_correct runs at 1 event in check_every (0: never)
+		unsigned check_countdown; // events before the next sampled check
+		uint32_t sampled_checks;
 		int	send_data (ccn_data* msg, const char *gatename, int gateindex, int line_of_the_call);
 		//</aa>
 };
@@ -0,0 +1,142 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef DOWNLOAD_TABLE_H_
+#define DOWNLOAD_TABLE_H_
+#include <omnetpp.h>
+#include <vector>
+#include "ccnsim.h"
+
+using namespace std;
+
+//<aa> Maximum receiver window (the received bitmap of a download has a bit
+//per chunk of the window) </aa>
+#define MAX_WINDOW 64
+
+//Each of these entries contains information about the current downloads
+struct download {
+    filesize_t chunk; //number of chunks that still miss within the file
+		//<aa> i.e. the first chunk not received yet </aa>
+
+    simtime_t start; //start time (for statistic purposes)
+    simtime_t last; //last time a chunk has been downloaded
+
+	//<aa>
+	#ifdef SEVERE_DEBUG
+		int serial_number;
+	#endif
+
+	unsigned long id; // Identifies the download in the deadline heap
+
+	// Receiver window: the chunks in [chunk,next) have been requested. The
+	// i-th bit of received is set iff chunk+i has already arrived
+	filesize_t next;
+	uint64_t received;
+	filesize_t first; // First chunk of the download
+
+	// Congestion control (see client::window_size)
+	unsigned slot; // Slot of the client pool storing the send times of the window
+	double cwnd;
+	double rtt_min;
+	double rtt_max;
+	filesize_t recovery; // No decrease until chunks sent after the last one come back
+
+	unsigned user; // User that started the download (see population_client)
+	//</aa>
+
+    download (double m = 0,simtime_t t = 0):chunk(m),start(t),last(t),id(0),next(m),received(0),first(m),
+		slot(0),cwnd(1),rtt_min(0),rtt_max(0),recovery(m),user(0){;}
+};
+
+//<aa>
+//Number of downloads of the same object stored without any allocation
+#define DOWNLOAD_INLINE 2
+
+// Concurrent downloads of the same object, in order of start. The first
+// DOWNLOAD_INLINE are stored in place, the others in an overflow vector.
+class download_list{
+    public:
+		download_list():n(0),more(NULL){;}
+		download_list(const download_list &other);
+		download_list &operator=(const download_list &other);
+		~download_list(){ delete more; }
+
+		unsigned size() const { return n; }
+		download &operator[](unsigned i){ 
+			return i < DOWNLOAD_INLINE ? first[i] : (*more)[i - DOWNLOAD_INLINE]; 
+		}
+
+		void push_back(const download &d);
+		// Remove the i-th download, keeping the order of the others
+		void erase(unsigned i);
+		void clear();
+		void swap(download_list &other);
+
+    private:
+		unsigned n;
+		download first[DOWNLOAD_INLINE];
+		vector<download> *more; // NULL until more than DOWNLOAD_INLINE downloads
+};
+
+
+// Current downloads of a client, indexed by object name. It is an open 
+// addressing hash table with linear probing, kept at most half full, so that
+// finding the downloads of the object of an incoming chunk costs O(1) on
+// average. Deletions shift back the following entries of the cluster instead
+// of leaving tombstones. The name 0 (never requested) marks the empty slots.
+//
+// Pointers returned by find and insert are valid until the next insert or 
+// erase.
+class download_table{
+    public:
+		download_table();
+
+		// Return the downloads of name, NULL if there is none
+		download_list *find(name_t name);
+		// Add a download of name
+		void insert(name_t name, const download &d);
+		// Remove all the downloads of name
+		void erase(name_t name);
+
+		// Number of objects being downloaded
+		unsigned size() const { return used; }
+
+    private:
+		struct entry{
+			name_t name;
+			download_list downloads;
+			entry():name(0){;}
+		};
+
+		unsigned home(name_t name) const;
+		unsigned lookup(name_t name) const; // slot of name, or the empty slot where it should go
+		void grow();
+
+		vector<entry> slots;
+		unsigned bits; // slots.size() == 2^bits
+		unsigned used;
+};
+//</aa>
+#endif
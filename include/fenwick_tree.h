@@ -0,0 +1,71 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef FENWICK_TREE_H_
+#define FENWICK_TREE_H_
+#include <vector>
+
+using namespace std;
+
+//<aa>
+// Fenwick (binary indexed) tree over non negative weights. It allows to
+// update the weight of a single element and to sample an element with
+// probability proportional to its weight, both in O(log n).
+// Elements are indexed from 0 to size()-1.
+//
+// The tree is rebuilt from the exact weights every 4*size() updates, so that
+// the rounding error accumulated by long sequences of updates stays bounded.
+class fenwick_tree{
+    public:
+		fenwick_tree():log_size(0),updates(0){;}
+		fenwick_tree(unsigned n);
+
+		// Change the number of elements. Old weights are kept, new elements
+		// have weight 0
+		void resize(unsigned n);
+		unsigned size() const { return values.size(); }
+
+		void set(unsigned i, double w);
+		void add(unsigned i, double delta){ set(i, values[i] + delta); }
+		double get(unsigned i) const { return values[i]; }
+
+		double total() const;
+		// Sum of the weights of the elements [0,i)
+		double prefix(unsigned i) const;
+
+		// Return the smallest i such that prefix(i+1) > u. With u uniformly
+		// drawn in [0,total()), i is drawn proportionally to its weight
+		unsigned find(double u) const;
+
+		void rebuild();
+
+    private:
+		vector<double> tree; // tree[0] is unused
+		vector<double> values; // exact weights
+		unsigned log_size; // highest power of 2 not greater than size()
+		unsigned long updates; // updates since the last rebuild
+};
+//</aa>
+#endif
@@ -26,6 +26,7 @@
 #define FIFO_CACHE_H_
 
 #include "base_cache.h"
+#include "memory_footprint.h" //<aa>
 #include <deque>
 #include <boost/unordered_map.hpp>
 using namespace std;
@@ -42,6 +43,7 @@ class fifo_cache: public base_cache{
 	virtual void data_store (chunk_t);
 	virtual bool data_lookup (chunk_t);
 	virtual bool full();
+	size_t index_footprint(); //<aa>
     private:
 	deque<chunk_t> deq;//Deque for the order 
 	unordered_map<chunk_t,bool> cache;//Map for a look up
@@ -0,0 +1,80 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef HDR_HISTOGRAM_H_
+#define HDR_HISTOGRAM_H_
+#include <stdint.h>
+
+using namespace std;
+
+//<aa>
+// Log-bucketed histogram of durations, in the style of HdrHistogram [hdr].
+// Values are recorded in microseconds. Each power of 2 is split into 
+// 2^(HDR_SUB_BITS-1) linear buckets, so that the relative error on any
+// recorded value is below 2^-(HDR_SUB_BITS-1) (1.6%), up to 2^HDR_MAX_BITS us
+// (about 200 days). Larger values are counted in the last bucket.
+//
+// Recording is a couple of shifts and an increment in a fixed array: it never
+// allocates. Histograms with the same layout are merged by summing the counts.
+#define HDR_SUB_BITS 7
+#define HDR_MAX_BITS 44
+#define HDR_BUCKETS ( ( (HDR_MAX_BITS - HDR_SUB_BITS) << (HDR_SUB_BITS - 1) ) + (1 << HDR_SUB_BITS) )
+#define HDR_UNITS_PER_SECOND 1e6
+
+class hdr_histogram{
+    public:
+		hdr_histogram(){ clear(); }
+
+		// Record a duration, in seconds
+		void record(double seconds){
+			uint64_t v = (uint64_t) (seconds * HDR_UNITS_PER_SECOND);
+			if (v >> HDR_MAX_BITS)
+				v = ( (uint64_t) 1 << HDR_MAX_BITS) - 1;
+			counts[index(v)]++;
+			total++;
+		}
+
+		void merge(const hdr_histogram &other);
+		void clear();
+
+		uint64_t count() const { return total; }
+		// Value (in seconds) below which the fraction q of the samples lies
+		double quantile(double q) const;
+
+    private:
+		static unsigned index(uint64_t v){
+			unsigned msb = 63 - __builtin_clzll(v | 1);
+			unsigned shift = msb < HDR_SUB_BITS ? 0 : msb - HDR_SUB_BITS + 1;
+			return (shift << (HDR_SUB_BITS - 1) ) + (unsigned) (v >> shift);
+		}
+
+		uint64_t counts[HDR_BUCKETS];
+		uint64_t total;
+};
+//</aa>
+#endif
+
+// References
+// [hdr] G. Tene, HdrHistogram: A High Dynamic Range Histogram, http://hdrhistogram.org
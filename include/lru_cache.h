@@ -27,6 +27,7 @@
 #define LRU_CACHE_H_
 #include <boost/unordered_map.hpp>
 #include "base_cache.h"
+#include "memory_footprint.h" //<aa>
 #include "ccnsim.h"
 
 
@@ -61,6 +62,8 @@ class lru_cache:public base_cache{
 		//</aa>
 	
 		bool full(); //<aa> moved from protected to public </aa>
+	
+		size_t index_footprint(); //<aa>
 
     protected:
 		void data_store(chunk_t);
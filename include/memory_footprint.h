@@ -0,0 +1,77 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef MEMORY_FOOTPRINT_H_
+#define MEMORY_FOOTPRINT_H_
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+using namespace std;
+
+//<aa>
+// Estimates of the heap memory used by the containers of the simulator, to
+// report the footprint of its main structures (see statistics::record_memory).
+// They follow the layout of libstdc++ and boost: a vector is one block of its
+// capacity, a deque is a map of 512 byte blocks, an unordered container is an
+// array of buckets plus one node (value and links) per element. Each block
+// allocated by malloc costs MALLOC_OVERHEAD more bytes, rounded up to 
+// MALLOC_ALIGN.
+#define MALLOC_OVERHEAD 8
+#define MALLOC_ALIGN 16
+#define DEQUE_BLOCK 512
+
+inline size_t heap_block(size_t bytes){
+	return (bytes + MALLOC_OVERHEAD + MALLOC_ALIGN - 1) / MALLOC_ALIGN * MALLOC_ALIGN;
+}
+
+template <class T>
+size_t footprint(const vector<T> &v){
+	return v.capacity() > 0 ? heap_block(v.capacity() * sizeof(T) ) : 0;
+}
+
+template <class T>
+size_t footprint(const deque<T> &d){
+	size_t per_block = sizeof(T) < DEQUE_BLOCK ? DEQUE_BLOCK / sizeof(T) : 1;
+	size_t blocks = d.size() / per_block + 1;
+	return blocks * heap_block(per_block * sizeof(T) ) + heap_block( (blocks + 2) * sizeof(void *) );
+}
+
+template <class K, class V, class H, class P, class A>
+size_t footprint(const boost::unordered_map<K, V, H, P, A> &m){
+	return heap_block(m.bucket_count() * sizeof(void *) ) + 
+		m.size() * heap_block(sizeof(pair<const K, V>) + 2 * sizeof(void *) );
+}
+
+template <class K, class H, class P, class A>
+size_t footprint(const boost::unordered_set<K, H, P, A> &s){
+	return heap_block(s.bucket_count() * sizeof(void *) ) + 
+		s.size() * heap_block(sizeof(K) + 2 * sizeof(void *) );
+}
+//</aa>
+#endif
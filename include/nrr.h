@@ -45,14 +45,21 @@ bool operator<(const Centry &a, const Centry &b){
 class nrr: public MonopathStrategyLayer{
     public:
 	void initialize();
+	~nrr(); //<aa>
 	bool *get_decision(cMessage *in);
 	bool *exploit(ccn_interest *interest);
-	int nearest(vector<int>&);
+	int nearest(const repo_view&);
 	void finish();
+	size_t fib_footprint(); //<aa>
     private:
+	//<aa> Positions in cfib of the nearest nodes holding the chunk, in
+	// the cfib order </aa>
+	void nearest_holders(chunk_t chunk, vector<int> &positions);
+
 	unordered_map<name_t,int_f> dynFIB;
 	unordered_set<chunk_t> ghost_list;
 	vector<Centry> cfib;
+	vector<int> cfib_position; //<aa> position in cfib of each node (-1 if not in cfib) </aa>
 	int TTL;
 
 };
@@ -27,6 +27,7 @@
 
 #include "MonopathStrategyLayer.h"
 class ccn_interest;
+class repo_view; //<aa> See content_distribution.h </aa>
 
 using namespace std;
 
@@ -37,7 +38,7 @@ class nrr1 : public MonopathStrategyLayer{
 	//Exploration and exploitation functions
 	bool *exploit(ccn_interest *);
 	bool *explore(ccn_interest *);
-	int  nearest(vector<int>& );
+	int  nearest(const repo_view& );
 	bool *exploit_nearest(ccn_interest *);
 
     private:
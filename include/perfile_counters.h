@@ -0,0 +1,90 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PERFILE_COUNTERS_H_
+#define PERFILE_COUNTERS_H_
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include "ccnsim.h"
+#include "memory_footprint.h"
+
+using namespace std;
+
+//<aa>
+// Per-file statistics: N 32 bit counters for each of the files [1,files].
+// The array is allocated once. Each row is tagged with the epoch of its last
+// update: clear() just starts a new epoch, and the counters of a row are 
+// zeroed lazily, when the row is first updated in the new epoch. Resetting 
+// the statistics at the cache-full and stability transitions is then O(1),
+// whatever the number of files.
+template <unsigned N>
+class perfile_counters{
+    public:
+		perfile_counters():epoch(1){;}
+
+		void resize(name_t files){
+			rows.assign(files + 1, row() );
+			epoch = 1;
+		}
+
+		void clear(){
+			if (++epoch == 0){
+				//The tags wrapped around: the old ones may look current
+				for (unsigned f = 0; f < rows.size(); f++)
+					rows[f].epoch = 0;
+				epoch = 1;
+			}
+		}
+
+		// Counter k of file f, to be updated
+		uint32_t &at(name_t f, unsigned k){
+			row &r = rows[f];
+			if (r.epoch != epoch){
+				r.epoch = epoch;
+				memset(r.counters, 0, sizeof(r.counters) );
+			}
+			return r.counters[k];
+		}
+
+		size_t memory_footprint() const { return footprint(rows); }
+
+		uint32_t get(name_t f, unsigned k) const{
+			const row &r = rows[f];
+			return r.epoch == epoch ? r.counters[k] : 0;
+		}
+
+    private:
+		struct row{
+			uint32_t epoch;
+			uint32_t counters[N];
+			row():epoch(0){ memset(counters, 0, sizeof(counters) ); }
+		};
+
+		vector<row> rows;
+		uint32_t epoch;
+};
+//</aa>
+#endif
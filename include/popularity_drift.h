@@ -0,0 +1,98 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef POPULARITY_DRIFT_H_
+#define POPULARITY_DRIFT_H_
+#include <omnetpp.h>
+#include <vector>
+#include <algorithm>
+#include "ccnsim.h"
+
+using namespace std;
+
+//<aa>
+// Contents of the most popular ranks, when the ranking drifts. They are kept
+// in a circular list starting at head, so that rotating the ranking costs 
+// O(1). Ranks outside the list keep their initial content (rank r, name r).
+class drift_ranking{
+    public:
+		drift_ranking():head(0){;}
+
+		// The first range ranks can drift. Initially, rank r has name r
+		void resize(unsigned range){
+			contents.resize(range);
+			for (unsigned r = 0; r < range; r++)
+				contents[r] = r + 1;
+			head = 0;
+		}
+		unsigned size() const { return contents.size(); }
+
+		name_t content(name_t rank) const {
+			return rank <= contents.size() ? contents[slot(rank - 1)] : rank;
+		}
+
+		// Exchange the contents of two ranks, in [0,size())
+		void swap(unsigned r1, unsigned r2){
+			std::swap(contents[slot(r1)], contents[slot(r2)]);
+		}
+
+		// Move each content up by one rank, the most popular one to the last
+		void rotate(){ head = slot(1); }
+
+    private:
+		unsigned slot(unsigned r) const { return (head + r) % contents.size(); }
+
+		vector<name_t> contents;
+		unsigned head;
+};
+
+// Change over time the ranking of the contents, when the request_model of
+// content_distribution is "drift". The weight of each rank is the Zipf one and
+// never changes: only the assignment of the contents to the ranks does.
+// Every drift_period seconds one drift event is applied to the drift_range
+// most popular ranks:
+//	- swap: drift_swaps pairs of ranks, drawn uniformly, exchange their contents
+//	- shift: the contents move up by one rank and the most popular one goes 
+//		to the last rank of the range. Repeating this event cyclically 
+//		rotates the popularity, e.g. to model daily cycles.
+// An event only changes the ranking (see content_distribution::popularity):
+// a swap costs O(1) and so does a shift, whatever the range.
+class popularity_drift : public cSimpleModule{
+    protected:
+		virtual void initialize();
+		virtual void handleMessage(cMessage *);
+		virtual void finish();
+
+    private:
+		bool shift; // Otherwise swap
+		double period;
+		unsigned swaps;
+
+		drift_ranking *ranking;
+		unsigned long events; // events that actually changed the ranking
+		cMessage *drift_timer;
+};
+//</aa>
+#endif
@@ -0,0 +1,63 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef POPULATION_CLIENT_H_
+#define POPULATION_CLIENT_H_
+#include <omnetpp.h>
+#include <vector>
+#include "ccnsim.h"
+#include "client.h"
+
+using namespace std;
+
+//<aa>
+// Population of users attached to the same node. Each user issues requests 
+// as a Poisson process of rate lambda: the superposition of their processes
+// is a single Poisson process of rate users*lambda, whose arrivals are 
+// assigned to users drawn uniformly. A single module and a single timer
+// handle the whole population, whatever its size.
+//
+// The per-user state is kept in arrays indexed by user. When replaying a 
+// trace, the user of a record is its client field (modulo users).
+class population_client : public client{
+    protected:
+		virtual void initialize();
+		virtual void finish();
+
+		virtual void request_file();
+		virtual double arrival_rate();
+		virtual void download_completed(const download &, simtime_t completion_time);
+
+    public:
+		virtual void clear_stat();
+
+    private:
+		unsigned users;
+
+		vector<uint32_t> user_downloads; // Completed downloads of each user
+		vector<float> user_time; // Total download time of each user
+};
+//</aa>
+#endif
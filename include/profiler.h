@@ -0,0 +1,107 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PROFILER_H_
+#define PROFILER_H_
+#include <stdint.h>
+#include <vector>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+using namespace std;
+
+//<aa>
+// Opt-in profiler of the simulator itself. When PROFILER is defined (see
+// ccnsim.h), each PROFILE_SCOPE counts an event and accumulates the TSC
+// cycles spent until the end of the enclosing block, per section and per
+// node. Scopes nest: the time of a section includes the time of the sections
+// it calls (e.g. core_layer includes the cache lookups). statistics prints
+// the report, sorted by cycles, at finish.
+// When PROFILER is not defined, PROFILE_SCOPE expands to nothing.
+enum profile_section{
+    PROFILE_CORE,		// core_layer::handleMessage
+    PROFILE_CLIENT,		// client::handleMessage
+    PROFILE_STATISTICS,	// statistics::handleMessage
+    PROFILE_STRATEGY,	// strategy_layer::get_decision
+    PROFILE_LOOKUP,		// base_cache::lookup
+    PROFILE_STORE,		// base_cache::store
+    PROFILE_SECTIONS
+};
+
+struct profile_entry{
+    uint64_t events;
+    uint64_t cycles;
+    profile_entry():events(0),cycles(0){;}
+};
+
+class profiler{
+    public:
+		static inline uint64_t ticks(){
+			#if defined(__i386__) || defined(__x86_64__)
+			return __rdtsc();
+			#else
+			struct timespec t;
+			clock_gettime(CLOCK_MONOTONIC, &t);
+			return t.tv_sec * 1000000000ULL + t.tv_nsec;
+			#endif
+		}
+
+		static inline void add(profile_section section, int node, uint64_t cycles){
+			vector<profile_entry> &nodes = entries[section];
+			if ( (unsigned) node >= nodes.size() )
+				nodes.resize(node + 1);
+			nodes[node].events++;
+			nodes[node].cycles += cycles;
+		}
+
+		// Print the sections and the busiest nodes, sorted by cycles
+		static void report();
+
+    private:
+		static vector<profile_entry> entries[PROFILE_SECTIONS];
+};
+
+class profile_scope{
+    public:
+		profile_scope(profile_section section_, int node_)
+			:section(section_),node(node_ < 0 ? 0 : node_),start(profiler::ticks() ){;}
+		~profile_scope(){ profiler::add(section, node, profiler::ticks() - start); }
+
+    private:
+		profile_section section;
+		int node;
+		uint64_t start;
+};
+
+#ifdef PROFILER
+#define PROFILE_SCOPE(section, node) profile_scope profile_scope_(section, node)
+#else
+#define PROFILE_SCOPE(section, node)
+#endif
+//</aa>
+#endif
@@ -26,6 +26,7 @@
 #define R_CACHE_H_
 
 #include "base_cache.h"
+#include "memory_footprint.h" //<aa>
 #include <boost/unordered_map.hpp>
 #include <omnetpp.h>
 #include <deque>
@@ -45,6 +46,7 @@ class random_cache: public base_cache{
 	bool data_lookup(chunk_t);
 	void data_store(chunk_t);
 	bool full();
+	size_t index_footprint(); //<aa>
 
 	//Deprecated
 	bool warmup();
@@ -29,6 +29,7 @@
 
 using namespace std;
 class ccn_interest;
+class repo_view; //<aa> See content_distribution.h </aa>
 
 
 class random_repository : public MonopathStrategyLayer{
@@ -37,6 +38,6 @@ class random_repository : public MonopathStrategyLayer{
     protected:
 	//Exploration and exploitation functions
 	bool *exploit(ccn_interest *);
-	int random(vector<int>&);
+	int random(const repo_view&);
 };
 #endif
@@ -0,0 +1,60 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef RANK_PERMUTATION_H_
+#define RANK_PERMUTATION_H_
+#include <stdint.h>
+#include "ccnsim.h"
+
+//<aa>
+// Pseudo random bijection of [1,F] onto itself, identified by a key. It is
+// used to give each region its own popularity ranking without any per-region
+// table: a client draws a rank from the shared distribution and requests the
+// content the permutation of its region associates to that rank.
+//
+// The permutation is a balanced Feistel network over the smallest domain
+// [0,2^(2h)) containing [0,F). Values falling outside [0,F) are encrypted
+// again (cycle walking) until they fall inside: since the domain is less than
+// 4 times larger than F, less than 4 rounds of encryption are needed on
+// average.
+#define FEISTEL_ROUNDS 4
+
+class rank_permutation{
+    public:
+		rank_permutation(name_t F, uint64_t key);
+
+		// Content of the given rank, in [1,F]
+		name_t map(name_t rank) const;
+
+    private:
+		uint32_t encrypt(uint32_t x) const;
+
+		name_t F;
+		unsigned half_bits;
+		uint32_t half_mask;
+		uint32_t round_keys[FEISTEL_ROUNDS];
+};
+//</aa>
+#endif
@@ -0,0 +1,92 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef REQUEST_BUFFER_H_
+#define REQUEST_BUFFER_H_
+#include <stdint.h>
+#include <vector>
+#include "ccnsim.h"
+
+using namespace std;
+
+//<aa>
+// Random draws of the request process of a client, generated in blocks.
+// Instead of drawing one inter-arrival time and one popularity value per
+// ARRIVAL event through the OMNeT++ RNG, a whole block is generated at once
+// by a local xoshiro256** generator [xoshiro], seeded by the RNG of the 
+// client: the sequence only depends on the seed of the run.
+//
+// Inter-arrival times are exponential with rate 1 (to be scaled by the 
+// actual rate). When the popularity is static (irm), the names are also
+// precomputed, by a batch Zipf sampler. Otherwise, only the uniforms are
+// buffered and are mapped to names when they are consumed, as the 
+// distribution changes over time.
+class request_buffer{
+    public:
+		request_buffer():block(0),names(false),next_gap_(0),next_p(0){;}
+
+		void initialize(uint64_t seed, unsigned block, bool names);
+
+		double next_gap(){
+			if (next_gap_ == gaps.size() )
+				refill_gaps();
+			return gaps[next_gap_++];
+		}
+
+		double next_uniform(){
+			if (next_p == uniforms.size() )
+				refill_popularity();
+			return uniforms[next_p++];
+		}
+
+		// Only if initialized with names
+		name_t next_name(){
+			if (next_p == uniforms.size() )
+				refill_popularity();
+			return drawn_names[next_p++];
+		}
+
+		bool has_names() const { return names; }
+
+    private:
+		void refill_gaps();
+		void refill_popularity();
+		double uniform(); // In (0,1)
+
+		uint64_t state[4];
+		unsigned block;
+		bool names;
+
+		vector<double> gaps;
+		vector<double> uniforms;
+		vector<name_t> drawn_names;
+		unsigned next_gap_;
+		unsigned next_p;
+};
+//</aa>
+#endif
+
+// References
+// [xoshiro] D. Blackman, S. Vigna, "Scrambled Linear Pseudorandom Number Generators", ACM TOMS, 2021
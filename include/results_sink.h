@@ -0,0 +1,110 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef RESULTS_SINK_H_
+#define RESULTS_SINK_H_
+#include <omnetpp.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+//<aa>
+// Binary columnar results file, written instead of the per node scalars and
+// of the per file vectors when the results_file parameter of statistics is
+// set. Each result is a row (node, file, metric, value):
+//	- node is the index of the node or client (-1 for network wide results)
+//	- file is the content the value refers to, 0 for the aggregate over all
+//	  the contents (e.g. the p_hit of a node)
+//	- for the link_* metrics, node and file are the two ends of the link
+//	- for the level_* metrics, node is the level
+//	- metric identifies the name of the result in the metric table
+//
+// The file is made of a header, the metric table and one array per column.
+// The rows are sorted by metric, so that the metric table is also an index:
+// each entry gives the range of rows of the metric. All the fields are little
+// endian. scripts/results2csv.py converts the file to csv.
+//
+#define RESULTS_MAGIC "CCNRSLTS"
+#define RESULTS_VERSION 1
+
+#pragma pack(push)
+#pragma pack(1)
+struct results_header{
+    char magic[8];
+    uint32_t version;
+    uint32_t metrics; // entries of the metric table
+    uint64_t rows;
+    // Offsets of the columns from the beginning of the file. The columns are
+    // int32 node, uint32 file, uint16 metric, double value
+    uint64_t node_offset;
+    uint64_t file_offset;
+    uint64_t metric_offset;
+    uint64_t value_offset;
+};
+
+// Entry of the metric table, followed by name_len characters (the name)
+struct results_metric{
+    uint64_t first_row;
+    uint64_t rows;
+    uint16_t name_len;
+};
+#pragma pack(pop)
+
+
+class results_sink{
+    public:
+		// Start collecting the results, to be written in path (called by statistics)
+		static void open(const string &path);
+		// Write the file and stop collecting
+		static void close();
+		static bool enabled(){ return sink != NULL; }
+
+		static void add(int node, uint32_t file, const char *metric, double value);
+
+    private:
+		results_sink(const string &path_):path(path_){;}
+		void write();
+
+		static results_sink *sink;
+
+		string path;
+		vector<string> metric_names;
+		map<string, uint16_t> metric_ids;
+
+		vector<int32_t> nodes;
+		vector<uint32_t> files;
+		vector<uint16_t> metrics;
+		vector<double> values;
+};
+
+// Record a result of node: in the results file if any, as the scalar
+// metric[node] otherwise. With node == -1 (network wide result) the scalar
+// is named metric and it is recorded in both.
+void record_result(cComponent *module, const char *metric, int node, double value);
+//</aa>
+#endif
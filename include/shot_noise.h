@@ -0,0 +1,111 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHOT_NOISE_H_
+#define SHOT_NOISE_H_
+#include <omnetpp.h>
+#include <vector>
+#include <queue>
+#include <string>
+#include "ccnsim.h"
+#include "fenwick_tree.h"
+
+using namespace std;
+
+//<aa>
+// Shot Noise Model (SNM) of the request process [snm]. Contents are born
+// according to a Poisson process, live for a random lifetime and, while
+// alive, are requested with a rate that follows their popularity profile:
+//
+//	rate(t) = V * profile(t - birth)
+//
+// where the volume V is Pareto distributed. Two profiles are supported:
+//	- box: constant rate V/L during the whole lifetime L (L exponential)
+//	- exp: rate decaying as exp(-t/tau)/tau. The decay is approximated by
+//		piecewise constant steps; the content dies after 4*tau.
+//
+// The rates of active contents are kept in a Fenwick tree, so that drawing
+// the next requested content costs O(log active). Births, rate updates and
+// deaths are kept in a calendar (a min heap on the event time) and are
+// processed lazily, when a request is drawn.
+//
+// Born contents take their names round robin from the catalog [1,F], so that
+// the size and the repositories of a content are those of the catalog entry
+// it reuses. The names still used by living contents are skipped: two
+// contents never share a name. F must then be much larger than the number of
+// active contents, and the simulation stops if all the names are in use.
+struct snm_event{
+    double time;
+    unsigned slot;
+    unsigned step; // Index of the profile step that starts at time
+    bool operator>(const snm_event &other) const { return time > other.time; }
+};
+
+class shot_noise_distribution{
+    public:
+		shot_noise_distribution(cRNG *rng, name_t F, double birth_rate,
+					double lifetime, double volume_shape, string profile);
+
+		// Populate the system with the contents that are alive at time now
+		void initialize(double now);
+
+		// Return the name of the content requested at time now. p must be
+		// uniformly distributed in [0,1)
+		name_t value(double now, double p);
+
+		unsigned get_active() const { return active; }
+
+    private:
+		void advance(double now);
+		void birth(double t);
+		void process(const snm_event &e);
+		double step_rate(unsigned slot, unsigned step);
+
+		double exponential(double mean);
+
+		cRNG *rng;
+		name_t F;
+		double birth_rate;
+		double lifetime;
+		double volume_shape;
+		bool exp_profile;
+
+		fenwick_tree rates; // Current rate of each slot (0 if the slot is free)
+		vector<name_t> names; // Content using each slot
+		vector<double> volumes; // Volume of the content using each slot
+		vector<double> lifetimes; // Lifetime (or decay constant) of each slot
+		vector<unsigned> free_slots;
+		vector<bool> alive; // alive[name]: name is used by a living content
+
+		priority_queue<snm_event, vector<snm_event>, greater<snm_event> > calendar;
+		double next_birth;
+		name_t last_name;
+		unsigned active;
+};
+//</aa>
+#endif
+
+// References
+// [snm] S. Traverso, M. Ahmed, M. Garetto, P. Giaccone, E. Leonardi, S. Niccolini, "Temporal Locality in Today's Content Caching: Why it Matters and How to Model it", ACM SIGCOMM CCR, 2013
@@ -28,6 +28,7 @@
 #include "MonopathStrategyLayer.h"
 
 class ccn_interest;
+class repo_view; //<aa> See content_distribution.h </aa>
 using namespace std;
 
 
@@ -37,6 +38,6 @@ class spr : public MonopathStrategyLayer{
     protected:
 	//Exploration and exploitation functions
 	bool *exploit(ccn_interest *);
-	int nearest(vector<int>&);
+	int nearest(const repo_view&);
 };
 #endif
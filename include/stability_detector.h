@@ -0,0 +1,102 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef STABILITY_DETECTOR_H_
+#define STABILITY_DETECTOR_H_
+#include <vector>
+#include <string>
+
+using namespace std;
+
+//<aa>
+// Detectors of the stability of the hit rate of a node. The hit rate is
+// sampled every ts seconds; a node is stable when the standard deviation of
+// its samples over window seconds (i.e. over window/ts samples) is not larger
+// than variance_threshold. All the detectors update their statistics in O(1)
+// per sample:
+//	- welford: tumbling windows. The mean and the variance are computed with
+//		Welford's streaming algorithm and the verdict is given at the end of 
+//		each window, as in the former implementation
+//	- sliding: window sliding by one sample. The samples of the window are kept
+//		in a ring and the verdict is given at every sample, once the ring is full
+//	- ewma: exponentially weighted mean and variance, with smoothing factor
+//		1/(samples per window). The verdict is given at every sample, after 
+//		a first window
+class stability_detector{
+    public:
+		static stability_detector *create(const string &type, unsigned window_samples, double threshold);
+		virtual ~stability_detector(){;}
+
+		// Add a sample and return true if the samples are stable
+		virtual bool add(double sample) = 0;
+
+    protected:
+		stability_detector(unsigned window_samples_, double threshold_)
+			:window_samples(window_samples_),threshold(threshold_){;}
+
+		unsigned window_samples;
+		double threshold;
+};
+
+class welford_detector : public stability_detector{
+    public:
+		welford_detector(unsigned window_samples, double threshold)
+			:stability_detector(window_samples, threshold),n(0),mean(0),m2(0){;}
+		virtual bool add(double sample);
+
+    private:
+		unsigned n;
+		double mean;
+		double m2; // Sum of the squared deviations from the mean
+};
+
+class sliding_detector : public stability_detector{
+    public:
+		sliding_detector(unsigned window_samples, double threshold)
+			:stability_detector(window_samples, threshold),ring(window_samples),
+			 next(0),n(0),mean(0),m2(0){;}
+		virtual bool add(double sample);
+
+    private:
+		vector<double> ring;
+		unsigned next; // Position of the oldest sample, once the ring is full
+		unsigned n;
+		double mean;
+		double m2;
+};
+
+class ewma_detector : public stability_detector{
+    public:
+		ewma_detector(unsigned window_samples, double threshold)
+			:stability_detector(window_samples, threshold),n(0),mean(0),var(0){;}
+		virtual bool add(double sample);
+
+    private:
+		unsigned n;
+		double mean;
+		double var;
+};
+//</aa>
+#endif
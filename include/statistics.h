@@ -29,6 +29,9 @@
 #include <boost/unordered_set.hpp>
 #include <boost/unordered_map.hpp>
 #include <vector>
+#include <fstream>
+#include "hdr_histogram.h" //<aa>
+#include "stability_detector.h" //<aa>
 
 
 class client;
@@ -47,12 +50,41 @@ using namespace boost;
  * the stabilization of all the hit rate of all nodes. 
  *
  */
+//<aa> Counters of the nodes of a level of the network </aa>
+struct level_counters{
+	double hits;
+	double misses;
+	double decision_yes;
+	double decision_no;
+	double interests; // received by the core layers
+	double forwarded; // interests sent toward other nodes
+	level_counters():hits(0),misses(0),decision_yes(0),decision_no(0),interests(0),forwarded(0){;}
+};
+
+//<aa> Batch means of a metric: sums of the means and of their squares </aa>
+struct batch_sums{
+	unsigned n;
+	double sum;
+	double sum2;
+
+	batch_sums():n(0),sum(0),sum2(0){;}
+	void add(double x){ n++; sum += x; sum2 += x*x; }
+	double mean() const { return sum / n; }
+	// Half width of the 95% confidence interval on the mean, relative to the mean
+	double relative_half_width() const;
+};
+
 class statistics : public cSimpleModule{
 
 	//<aa>
 	public:
 //		virtual void registerIcnChannel(int gate_id);
 		virtual void registerIcnChannel(cChannel* icn_channel);
+
+		//Called by a cache at the first store that makes it full
+		void cache_full();
+
+		~statistics();
 	//</aa>
 
     protected:
@@ -74,6 +106,27 @@ class statistics : public cSimpleModule{
 	
 	//<aa> Perform the operations to do after having reached the stability
 	void stability_has_been_reached();
+
+	void record_quantiles(const char *metric, const hdr_histogram &histogram);
+
+	// Close a batch of the steady state and check the confidence intervals
+	bool batch_means_converged();
+
+	// Record the estimated memory of the main structures, at the given phase
+	void record_memory(const char *phase);
+
+	// Append a line to the telemetry file
+	void write_telemetry();
+
+	// Record the traffic carried by each registered link
+	void record_link_load();
+
+	// Per level statistics: assignment of the nodes to the levels, sum of
+	// the counters of the nodes of each level, final scalars and samples
+	void init_levels();
+	vector<level_counters> collect_levels();
+	void record_levels();
+	void sample_levels();
 	//</aa>
 
 
@@ -81,6 +134,11 @@ class statistics : public cSimpleModule{
 	cMessage *full_check;
 	cMessage *stable_check;
 	cMessage *end;
+	//<aa>
+	cMessage *batch_check;
+	cMessage *telemetry;
+	cMessage *level_sample;
+	//</aa>
 
 	//Vector for accessing different modules statistics
 	client** clients;
@@ -88,6 +146,8 @@ class statistics : public cSimpleModule{
 	base_cache** caches;
 	//<aa>
 	vector<cChannel*> icn_channels;
+	double link_capacity; // bps of the links whose channel has no datarate
+	double last_clear; // time of the last clear_stat
 	//</aa>
 	
 
@@ -102,13 +162,45 @@ class statistics : public cSimpleModule{
 	double time_steady;
 	double stabilization_time;
 	//<aa>
+	int full_caches; // caches that notified they are full
+
+	//Termination of the steady state: after steady seconds or, with
+	//batch_means, as soon as the confidence intervals are narrow enough
+	bool batch_means;
+	double batch_time;
+	unsigned min_batches;
+	double ci_target;
+
+	//Cumulative counters at the end of the last batch
+	double last_hits, last_requests, last_hops, last_chunks;
+	//Running sums of the batch means, to compute their variance
+	batch_sums hit_batches, distance_batches;
+
+	//Telemetry: a line every telemetry_period wall clock seconds
+	const char *phase; // filling, stabilising or steady
+	ofstream telemetry_file;
+	double telemetry_period;
+	double last_wall; // wall clock time of the last line
+	double last_sim;
+	int64_t last_events;
+	//</aa>
+	//<aa>
 	double variance_threshold;
 	//</aa>
 
 	//Stabilization samples
-	vector< vector <double> > samples;
-	unordered_map <int, unordered_set <int> > level_union;
-	unordered_map <int, int> level_same;
+	//<aa> It was vector< vector <double> > samples. A detector per node 
+	// keeps the streaming statistics of its hit rate samples </aa>
+	vector<stability_detector *> detectors;
+	//<aa> They were unordered_map <int, unordered_set <int> > level_union
+	// and unordered_map <int, int> level_same, never used
+	vector<int> node_level; // level of caches[i] and cores[i]
+	int levels;
+	double level_sampling;
+	vector<level_counters> last_levels; // counters at the last sample
+	vector<cOutVector *> level_hit_vectors;
+	vector<cOutVector *> level_forwarded_vectors;
+	//</aa>
 
 	//<aa>
 	int total_replicas;
@@ -68,6 +68,9 @@ class strategy_layer: public abstract_node{
 		 */
 		//</aa>
 		virtual bool* get_decision(cMessage *)=0;
+
+		//<aa> Estimated heap memory of the FIB (see memory_footprint.h) </aa>
+		virtual size_t fib_footprint();
 		
 		static ifstream fdist;
 		static ifstream frouting;
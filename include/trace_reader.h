@@ -0,0 +1,121 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef TRACE_READER_H_
+#define TRACE_READER_H_
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+//<aa>
+// Binary request traces, replayed by the clients (see the trace_file
+// parameter of client). A trace is a header followed by records sorted by
+// time. It can be produced from a csv file with scripts/csv2trace.py.
+// All the fields are little endian.
+//
+#define TRACE_MAGIC "CCNTRACE"
+#define TRACE_VERSION 1
+
+#pragma pack(push)
+#pragma pack(1)
+struct trace_header{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size; // sizeof(trace_record)
+    uint64_t records; // number of records following the header
+};
+
+struct trace_record{
+    uint64_t time; // microseconds since the beginning of the trace
+    uint32_t client; // user issuing the request
+    uint32_t object; // requested object, in [1,objects]
+    uint32_t chunk; // first chunk to download
+};
+#pragma pack(pop)
+
+
+// A trace is memory mapped and read sequentially, once, whatever the number
+// of clients replaying it. The users of the trace are spread among the
+// clients that subscribed to it (user u is replayed by the subscriber
+// u % subscribers). When a client asks for its next record, the reader
+// advances in the file and queues the records met on the way for the other
+// subscribers. As records are sorted by time, the queues stay short.
+// A queue holds at most TRACE_QUEUE records, though: when it is full, its
+// subscriber stops being served by the shared cursor and will read its
+// records again, by itself, from the position where its queue overflowed.
+// The records of each subscriber are counted by a first pass over the file,
+// so that the reader stops as soon as a subscriber has no more records.
+// The kernel is asked to read ahead the next window of the file and to drop
+// the windows already consumed, so that the resident memory is bounded
+// whatever the trace length.
+class trace_reader{
+    public:
+		// Return the reader of the given file, shared by all the clients
+		static trace_reader *open(const string &path);
+		// Give back a reader obtained by open(). The last release unmaps the file
+		static void release(trace_reader *reader);
+
+		// Register a new replaying client and return its identifier
+		unsigned subscribe();
+
+		// Get the next record of the subscriber. Return false at the end of the trace
+		bool next(unsigned subscriber, trace_record &record);
+
+		uint64_t get_records() const { return records; }
+
+    private:
+		trace_reader(const string &path);
+		~trace_reader();
+
+		void count_records();
+		void read_ahead();
+		void drop_before(uint64_t record);
+		bool own_scan(unsigned subscriber, trace_record &record);
+
+		string path;
+		int fd;
+		const char *map_base;
+		size_t map_len;
+		const trace_record *first;
+		uint64_t records;
+		uint64_t cursor; // next record to be read from the file
+		uint64_t advised; // records before advised have already been advised
+
+		// Per subscriber
+		vector< deque<trace_record> > pending; // records read but not yet replayed
+		vector<uint64_t> resume; // where to scan from, after an overflow of pending (or NO_RESUME)
+		vector<uint64_t> remaining; // records not yet replayed
+		bool counted;
+
+		unsigned references;
+
+		static map<string, trace_reader *> readers;
+};
+//</aa>
+#endif
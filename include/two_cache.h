@@ -26,6 +26,7 @@
 #define TWO_CACHE_H_
 
 #include "base_cache.h"
+#include "memory_footprint.h" //<aa>
 #include <deque>
 #include <boost/unordered_map.hpp>
 
@@ -43,6 +44,7 @@ class two_cache: public base_cache{
 	virtual void data_store(chunk_t);
 	virtual bool data_lookup(chunk_t);
 	virtual bool full();
+	size_t index_footprint(); //<aa>
 
     private:
 	deque<uint64_t> deq;
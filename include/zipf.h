@@ -39,8 +39,18 @@ class zipf_distribution{
 		//		probabilities of contents from 0 to y is p </aa>
 		unsigned int value (double p);
 
+		//<aa> Batch version of value: out[i] = value(p[i]). Each search
+		// starts from a guide table over [0,1), built at the first call,
+		// and only looks inside the bucket of p[i] </aa>
+		void values (const double *p, unsigned int *out, unsigned n);
+
 		//<aa>
 		double get_normalization_constant();
+
+		// Probability of the content of rank i, in [1,F]
+		double pmf(unsigned int i);
+
+		size_t memory_footprint();
 		//</aa> 
 		
 
@@ -52,6 +62,8 @@ class zipf_distribution{
 
 		//<aa>
 		double normalization_constant;
+		vector<unsigned> guide; // Inverse-CDF buckets of values()
+		void guide_initialize();
 		//</aa>
 };
 #endif
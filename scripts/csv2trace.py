@@ -0,0 +1,51 @@
+#!/usr/bin/env python
+#
+# Convert a csv request trace into the binary format replayed by the ccnSim
+# clients (see include/trace_reader.h and the trace_file parameter).
+#
+# Each line of the csv is
+#	time,client,object,chunk
+# where time is in seconds since the beginning of the trace, client is the
+# user issuing the request, object is in [1,objects] and chunk is the first
+# chunk to download (0 to download the whole object). Lines must be sorted by
+# time. A first line that is not numeric is considered as a header and skipped.
+#
+# Usage: csv2trace.py trace.csv trace.bin
+import csv
+import struct
+import sys
+
+MAGIC = b"CCNTRACE"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQ")
+RECORD = struct.Struct("<QIII")
+
+def convert(src, dst):
+	records = 0
+	last = 0
+	with open(src) as f, open(dst, "wb") as out:
+		out.write(HEADER.pack(MAGIC, VERSION, RECORD.size, 0))
+		for line, row in enumerate(csv.reader(f), 1):
+			if not row:
+				continue
+			try:
+				time = int(round(float(row[0]) * 1e6))
+				client, obj, chunk = [int(x) for x in row[1:4]]
+			except (ValueError, IndexError):
+				if records == 0 and line == 1:
+					continue
+				sys.exit("%s:%d: malformed line" % (src, line))
+			if time < last:
+				sys.exit("%s:%d: the trace is not sorted by time" % (src, line))
+			last = time
+			out.write(RECORD.pack(time, client, obj, chunk))
+			records += 1
+		#The number of records is known only now
+		out.seek(0)
+		out.write(HEADER.pack(MAGIC, VERSION, RECORD.size, records))
+	print("%d records written to %s" % (records, dst))
+
+if __name__ == "__main__":
+	if len(sys.argv) != 3:
+		sys.exit("Usage: %s trace.csv trace.bin" % sys.argv[0])
+	convert(sys.argv[1], sys.argv[2])
@@ -1,2 +1,2 @@
 #!/bin/sh
-opp_makemake --deep -f -X  ./patch/   -X scripts/ -X networks/ -X modules/  -o ccnSim -X results/ -X ini/ -X manual/  -X doc/ -X file_routing/ -X ccn14distrib/ -X ccn14scripts/
+opp_makemake --deep -f -X  ./patch/   -X scripts/ -X test/ -X networks/ -X modules/  -o ccnSim -X results/ -X ini/ -X manual/  -X doc/ -X file_routing/ -X ccn14distrib/ -X ccn14scripts/
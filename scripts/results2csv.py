@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+#
+# Convert a binary columnar results file, written by ccnSim when the
+# results_file parameter is set (see include/results_sink.h), into csv.
+#
+# Each line of the output is
+#	metric,node,file,value
+# where node is -1 for network wide results and file is 0 for the results
+# that are not about a single content. With -m, only the given metrics are
+# converted: thanks to the index, the rest of the file is not read.
+#
+# Usage: results2csv.py [-m metric[,metric...]] results.res [results.csv]
+import struct
+import sys
+
+MAGIC = b"CCNRSLTS"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQQQQ")
+METRIC = struct.Struct("<QQH")
+
+def read_index(f):
+	magic, version, metrics, rows, node_off, file_off, metric_off, value_off = \
+		HEADER.unpack(f.read(HEADER.size))
+	if magic != MAGIC or version != VERSION:
+		sys.exit("Not a results file of version %d" % VERSION)
+	index = []
+	for m in range(metrics):
+		first, count, name_len = METRIC.unpack(f.read(METRIC.size))
+		index.append((f.read(name_len).decode(), first, count))
+	return index, (node_off, file_off, value_off)
+
+def column(f, offset, fmt, first, count):
+	size = struct.calcsize("<" + fmt)
+	f.seek(offset + first * size)
+	return struct.unpack("<%d%s" % (count, fmt), f.read(count * size))
+
+def convert(src, out, wanted=None):
+	with open(src, "rb") as f:
+		index, (node_off, file_off, value_off) = read_index(f)
+		out.write("metric,node,file,value\n")
+		for name, first, count in index:
+			if wanted is not None and name not in wanted:
+				continue
+			nodes = column(f, node_off, "i", first, count)
+			files = column(f, file_off, "I", first, count)
+			values = column(f, value_off, "d", first, count)
+			for node, file, value in zip(nodes, files, values):
+				out.write("%s,%d,%d,%r\n" % (name, node, file, value))
+
+if __name__ == "__main__":
+	args = sys.argv[1:]
+	wanted = None
+	if len(args) >= 2 and args[0] == "-m":
+		wanted = set(args[1].split(","))
+		args = args[2:]
+	if len(args) not in (1, 2):
+		sys.exit("Usage: %s [-m metric[,metric...]] results.res [results.csv]" % sys.argv[0])
+	if len(args) == 2:
+		with open(args[1], "w") as out:
+			convert(args[0], out, wanted)
+	else:
+		convert(args[0], sys.stdout, wanted)
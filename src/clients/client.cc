@@ -34,6 +34,9 @@
 
 //<aa>
 #include "error_handling.h"
+#include "rank_permutation.h"
+#include "results_sink.h"
+#include "profiler.h"
 //</aa>
 
 Register_Class (client);
@@ -53,18 +56,54 @@ void client::initialize(){
 		active = true;
 
 		//Parameters initialization
-		check_time      = par("check_time");
 		lambda          = par ("lambda");
 		RTT             = par("RTT");
+		check_time      = par("check_time"); //<aa> Only for retransmissions </aa>
+		//<aa>
+		W               = par("W");
+		if (W < 1 || W > MAX_WINDOW){
+			std::stringstream ermsg; 
+			ermsg<<"The window W="<<W<<" must be in [1,"<<MAX_WINDOW<<"]";
+			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+		}
+
+		string window_control = par("window_control").stdstringValue();
+		if (window_control.compare("aimd") == 0)
+			aimd = true;
+		else if (window_control.compare("fixed") == 0)
+			aimd = false;
+		else {
+			std::stringstream ermsg; 
+			ermsg<<"Window control \""<<window_control<<"\" incorrect. Valid values are fixed and aimd";
+			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+		}
+		aimd_beta = par("aimd_beta");
+		raaqm_pmax = par("raaqm_pmax");
+		send_slot_size = aimd ? MAX_WINDOW : W;
+
+		cc_trace_every = par("cc_trace_every");
+		cc_samples = 0;
+		if (cc_trace_every > 0){
+			char vector_name[30];
+			sprintf (vector_name, "cwnd[%d]", getNodeIndex() );
+			cwnd_vector.setName(vector_name);
+			sprintf (vector_name, "chunk_rtt[%d]", getNodeIndex() );
+			rtt_vector.setName(vector_name);
+		}
+		//</aa>
 
 		//Allocating file statistics
-		client_stats = new client_stat_entry[__file_bulk+1];
+		client_stats.resize(__file_bulk); //<aa> It was new client_stat_entry[__file_bulk+1] </aa>
 
 		//Initialize average stats
 		avg_distance = 0;
 		avg_time = 0;
 		tot_downloads = 0;
 		tot_chunks = 0;
+		next_download_id = 0; //<aa>
+		requesting_user = 0; //<aa>
+		completed_chunks = 0; //<aa>
+		completed_time = 0; //<aa>
 
 		//<aa>
 		#ifdef SEVERE_DEBUG
@@ -74,8 +113,38 @@ void client::initialize(){
 
 		arrival = new cMessage("arrival", ARRIVAL );
 		timer = new cMessage("timer", TIMER);
-		scheduleAt( simTime() + exponential(1./lambda), arrival);
-		scheduleAt( simTime() + check_time, timer  );
+
+		//<aa>
+		int region = par("region");
+		permutation = NULL;
+		if (region != 0)
+			permutation = new rank_permutation(content_distribution::catalog.size() - 1, region);
+
+		request_block = 0;
+		string trace_file = par("trace_file").stdstringValue();
+		trace = NULL;
+		if (trace_file.compare("") != 0){
+			trace = trace_reader::open(trace_file);
+			trace_id = trace->subscribe();
+			trace_start = simTime();
+			trace_skipped = 0;
+			record_pending = false;
+			// The first record can be read only when all the clients 
+			// subscribed to the trace, i.e. after the initialization
+			scheduleAt( simTime(), arrival);
+		} else {
+			request_block = par("request_block");
+			if (request_block > 0){
+				// The draws of the buffer only depend on the RNG of the client
+				uint64_t seed = ( (uint64_t) intrand(0x7fffffff) << 32) ^ intrand(0x7fffffff);
+				bool static_popularity = content_distribution::snm == NULL && 
+						content_distribution::popularity == NULL;
+				draws.initialize(seed, request_block, static_popularity);
+			}
+		//</aa>
+			scheduleAt( simTime() + next_interarrival(), arrival); //<aa> It was exponential(1./lambda) </aa>
+		} //<aa>
+		//<aa> The timer is scheduled as soon as a download starts </aa>
 
     }
 }
@@ -83,6 +152,7 @@ void client::initialize(){
 
 void client::handleMessage(cMessage *in)
 {
+	PROFILE_SCOPE(PROFILE_CLIENT, getIndex() ); //<aa>
     if (in->isSelfMessage()){
 		handle_timers(in);
 		return;
@@ -119,17 +189,6 @@ void client::handleMessage(cMessage *in)
 		//</aa>
     }
 
-	//<aa>
-	#ifdef SEVERE_DEBUG
-		if (client_stats == 0)
-		{
-			std::stringstream ermsg; 
-			ermsg<<"The pointer client_stats points to 0. This is an error."<<
-				" Is this node active? "<<active;
-			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-		}
-	#endif
-	//</aa>
 }
 
 int client::getNodeIndex(){
@@ -141,14 +200,16 @@ void client::finish(){
     //Output average local statistics
     if (active){
 	char name [30];
-	sprintf ( name, "hdistance[%d]", getNodeIndex());
-	recordScalar (name, avg_distance);
+	//<aa> The per client results go through record_result (see results_sink.h) </aa>
+	record_result(this, "hdistance", getNodeIndex(), avg_distance);
 
-	sprintf ( name, "downloads[%d]",getNodeIndex());
-	recordScalar (name, tot_downloads );
+	record_result(this, "downloads", getNodeIndex(), tot_downloads );
 
-	sprintf ( name, "avg_time[%d]",getNodeIndex());
-	recordScalar (name, avg_time);
+	record_result(this, "avg_time", getNodeIndex(), avg_time.dbl() );
+
+	//<aa> Average download throughput (chunks/s) </aa>
+	record_result(this, "throughput", getNodeIndex(),
+		completed_time > 0 ? completed_chunks / completed_time.dbl() : 0);
 
 	//<aa>
 	#ifdef SEVERE_DEBUG
@@ -168,14 +229,39 @@ void client::finish(){
 	//</aa>
 
 	//Output per file statistics
-	sprintf ( name, "hdistance[%d]", getNodeIndex());
-	cOutVector distance_vector(name);
-
-	for (name_t f = 1; f <= __file_bulk; f++)
-	    distance_vector.recordWithTimestamp(f, client_stats[f].avg_distance);
+	//<aa> In the results file, it is the hdistance of each file </aa>
+	if (results_sink::enabled() ){
+		for (name_t f = 1; f <= __file_bulk; f++){
+			uint32_t file_chunks = client_stats.get(f, CHUNKS_COUNTER);
+			results_sink::add(getNodeIndex(), f, "hdistance",
+				file_chunks ? client_stats.get(f, HOPS_COUNTER) * 1./file_chunks : 0);
+		}
+	} else {
+		sprintf ( name, "hdistance[%d]", getNodeIndex());
+		cOutVector distance_vector(name);
+
+		for (name_t f = 1; f <= __file_bulk; f++){
+			//<aa> It was client_stats[f].avg_distance </aa>
+			uint32_t file_chunks = client_stats.get(f, CHUNKS_COUNTER);
+			distance_vector.recordWithTimestamp(f, 
+					file_chunks ? client_stats.get(f, HOPS_COUNTER) * 1./file_chunks : 0);
+		}
+	}
+	//</aa>
 
 	//cancelAndDelete(timer);
 	//cancelAndDelete(arrival);
+
+	//<aa>
+	delete permutation;
+	permutation = NULL;
+
+	if (trace != NULL){
+		record_result(this, "trace_skipped", getNodeIndex(), trace_skipped );
+		trace_reader::release(trace);
+		trace = NULL;
+	}
+	//</aa>
 	
     }
 }
@@ -184,34 +270,18 @@ void client::finish(){
 void client::handle_timers(cMessage *timer){
     switch(timer->getKind()){
 	case ARRIVAL:
+	    //<aa>
+	    if (trace != NULL){
+			replay_trace();
+			break;
+	    }
+	    //</aa>
 	    request_file();
-	    scheduleAt( simTime() + exponential(1/lambda), arrival );
+	    scheduleAt( simTime() + next_interarrival(), arrival ); //<aa> It was exponential(1/lambda) </aa>
 	    break;
 	case TIMER:
-	    for (multimap<name_t, download >::iterator i = current_downloads.begin();i != current_downloads.end();i++){
-		if ( simTime() - i->second.last > RTT ){
-			//<aa>
-			#ifdef SEVERE_DEBUG
-			    chunk_t chunk = 0; 	// Allocate chunk data structure. 
-									// This value wiil be overwritten soon
-				name_t object_name = i->first;
-				chunk_t object_id = __sid(chunk, object_name);
-				std::stringstream ermsg; 
-				ermsg<<"Client attached to node "<< getNodeIndex() <<" was not able to retrieve object "
-					<<object_id<< " before the timeout expired. Serial number of the interest="<< 
-					i->second.serial_number <<". This is not necessarily a bug. If you expect "<<
-					"such an event and you think it is not a bug, disable this error message";
-				severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-			#endif
-			//</aa>
-			
-		    //resend the request for the given chunk
-		    cout<<getIndex()<<"]**********Client timer hitting ("<<simTime()-i->second.last<<")************"<<endl;
-		    cout<<i->first<<"(while waiting for chunk n. "<<i->second.chunk << ",of a file of "<< __size(i->first) <<" chunks at "<<simTime()<<")"<<endl;
-		    resend_interest(i->first,i->second.chunk,-1);
-		}
-	    }
-	    scheduleAt( simTime() + check_time, timer );
+	    //<aa> It was a scan of all the current downloads every check_time </aa>
+	    check_deadlines();
 	    break;
     }
 }
@@ -221,10 +291,27 @@ void client::handle_timers(cMessage *timer){
 //Generate interest requests 
 void client::request_file()
 {
-    name_t name = content_distribution::zipf.value(dblrand());
-	
+	//<aa> It was zipf.value(dblrand()) </aa>
+    name_t name;
+	if (request_block == 0)
+		name = content_distribution::draw_name(dblrand());
+	else if (draws.has_names() )
+		name = draws.next_name();
+	else
+		name = content_distribution::draw_name(draws.next_uniform() );
+
 	//<aa>
-	struct download new_download = download (0,simTime() );
+	if (permutation != NULL)
+		//The drawn name is the rank of the content in the region
+		name = permutation->map(name);
+
+	start_download(name, 0);
+}
+
+//<aa> Start downloading name from chunk first_chunk on
+void client::start_download(name_t name, cnumber_t first_chunk)
+{
+	struct download new_download = download (first_chunk,simTime() );
 	#ifdef SEVERE_DEBUG
 		new_download.serial_number = interests_sent;
 
@@ -244,10 +331,221 @@ void client::request_file()
 	#endif
 	//</aa>
 
-    current_downloads.insert(pair<name_t, download >(name, new_download ) );
-    send_interest(name, 0 ,-1);
+	//<aa>
+	new_download.id = next_download_id++;
+	new_download.slot = alloc_send_slot();
+	new_download.user = requesting_user;
+
+	fill_window(name, new_download, -1); // It was send_interest(name, first_chunk, -1)
+    current_downloads.insert(name, new_download); // It was a multimap insert
+
+	// Only once the download is in the table: schedule_timer() drops the
+	// entries of the downloads it cannot find
+	deadlines.push( download_deadline(new_download.last + RTT, name, new_download.id) );
+	schedule_timer();
+	//</aa>
+}
+
+//<aa>
+double client::arrival_rate()
+{
+	return lambda;
+}
+
+double client::next_interarrival()
+{
+	if (request_block == 0)
+		return exponential(1./arrival_rate() );
+	return draws.next_gap() / arrival_rate();
+}
+
+//<aa> Request the chunks of d up to the window size beyond the first missing one
+void client::fill_window(name_t name, download &d, int toward)
+{
+	unsigned window = window_size(d);
+	while (d.next < __size(name) && (unsigned) (d.next - d.chunk) < window){
+		send_times[d.slot * send_slot_size + d.next % send_slot_size] = simTime();
+		send_interest(name, d.next++, toward);
+	}
+}
+
+unsigned client::window_size(const download &d)
+{
+	if (!aimd)
+		return W;
+	unsigned window = (unsigned) d.cwnd;
+	return window > MAX_WINDOW ? MAX_WINDOW : window;
 }
 
+unsigned client::alloc_send_slot()
+{
+	if (!free_send_slots.empty() ){
+		unsigned slot = free_send_slots.back();
+		free_send_slots.pop_back();
+		return slot;
+	}
+	send_times.resize(send_times.size() + send_slot_size);
+	return send_times.size() / send_slot_size - 1;
+}
+
+// AIMD window control, in the style of ICP/RAAQM [icp]: the window grows by
+// one chunk per window of received chunks and is multiplied by aimd_beta at
+// each timeout. Moreover, as in RAAQM, each RTT sample triggers a decrease 
+// with a probability growing linearly from 0 (at the minimum RTT observed by
+// the download) to raaqm_pmax (at the maximum one). After a decrease, the 
+// window is not decreased again until the chunks sent after it come back.
+void client::rtt_sample(download &d, filesize_t chunk_num)
+{
+	double rtt = ( simTime() - send_times[d.slot * send_slot_size + chunk_num % send_slot_size] ).dbl();
+	if (d.rtt_max == 0 || rtt < d.rtt_min)
+		d.rtt_min = rtt;
+	if (rtt > d.rtt_max)
+		d.rtt_max = rtt;
+	chunk_rtt_histogram.record(rtt);
+
+	if (aimd){
+		double p = d.rtt_max > d.rtt_min ? 
+				raaqm_pmax * (rtt - d.rtt_min) / (d.rtt_max - d.rtt_min) : 0;
+		if (chunk_num >= d.recovery && dblrand() < p){
+			d.cwnd = d.cwnd * aimd_beta < 1 ? 1 : d.cwnd * aimd_beta;
+			d.recovery = d.next;
+		} else if (d.cwnd < MAX_WINDOW)
+			d.cwnd += 1. / d.cwnd;
+	}
+
+	if (cc_trace_every > 0 && ++cc_samples % cc_trace_every == 0){
+		rtt_vector.record(rtt);
+		if (aimd)
+			cwnd_vector.record(d.cwnd);
+	}
+}
+
+void client::window_timeout(download &d)
+{
+	if (!aimd)
+		return;
+	d.cwnd = d.cwnd * aimd_beta < 1 ? 1 : d.cwnd * aimd_beta;
+	d.recovery = d.next;
+}
+
+//<aa> The download of a heap entry, NULL if it has been completed
+download *client::find_download(const download_deadline &d)
+{
+	download_list *downloads = current_downloads.find(d.name);
+	if (downloads == NULL)
+		return NULL;
+	for (unsigned k = 0; k < downloads->size(); k++)
+		if ( (*downloads)[k].id == d.id)
+			return &(*downloads)[k];
+	return NULL;
+}
+
+//(Re)schedule the timer at the earliest deadline of a pending download
+void client::schedule_timer()
+{
+	while ( !deadlines.empty() && find_download(deadlines.top() ) == NULL )
+		deadlines.pop();
+
+	if (deadlines.empty() ){
+		if ( timer->isScheduled() )
+			cancelEvent(timer);
+		return;
+	}
+
+	simtime_t t = deadlines.top().deadline;
+	if ( timer->isScheduled() ){
+		if (timer->getArrivalTime() == t)
+			return;
+		cancelEvent(timer);
+	}
+	scheduleAt(t, timer);
+}
+
+//Resend the interests of the downloads that did not receive any chunk in the
+//last RTT. Only the expired entries of the heap are touched
+void client::check_deadlines()
+{
+	while ( !deadlines.empty() && deadlines.top().deadline <= simTime() )
+	{
+		download_deadline d = deadlines.top();
+		deadlines.pop();
+
+		download *found = find_download(d);
+		if (found == NULL)
+			//The download has been completed
+			continue;
+
+		download &dl = *found;
+		if ( simTime() - dl.last < RTT ){
+			//Some chunks arrived since the deadline was set
+			d.deadline = dl.last + RTT;
+			deadlines.push(d);
+			continue;
+		}
+
+		#ifdef SEVERE_DEBUG
+		    chunk_t chunk = 0; 	// Allocate chunk data structure. 
+								// This value wiil be overwritten soon
+			name_t object_name = d.name;
+			chunk_t object_id = __sid(chunk, object_name);
+			std::stringstream ermsg; 
+			ermsg<<"Client attached to node "<< getNodeIndex() <<" was not able to retrieve object "
+				<<object_id<< " before the timeout expired. Serial number of the interest="<< 
+				dl.serial_number <<". This is not necessarily a bug. If you expect "<<
+				"such an event and you think it is not a bug, disable this error message";
+			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+		#endif
+
+	    //resend the request for the given chunk
+	    cout<<getIndex()<<"]**********Client timer hitting ("<<simTime()-dl.last<<")************"<<endl;
+	    cout<<d.name<<"(while waiting for chunk n. "<<dl.chunk << ",of a file of "<< __size(d.name) <<" chunks at "<<simTime()<<")"<<endl;
+		//<aa> Resend all the chunks of the window still in flight </aa>
+		window_timeout(dl);
+		for (filesize_t c = dl.chunk; c < dl.next; c++)
+			if ( !(dl.received >> (c - dl.chunk) & 1) ){
+				send_times[dl.slot * send_slot_size + c % send_slot_size] = simTime();
+				resend_interest(d.name,c,-1);
+			}
+
+		//As the old periodic scan did, the interests are sent again every
+		//check_time until a chunk arrives
+		d.deadline = simTime() + check_time;
+		deadlines.push(d);
+	}
+	schedule_timer();
+}
+//</aa>
+
+//<aa> Replay the pending trace record (if any), then schedule the arrival of
+// the next valid one. The trace time is honored exactly: the replay is as 
+// fast as the event loop, whatever the trace duration.
+void client::replay_trace()
+{
+	if (record_pending){
+		requesting_user = next_record.client;
+		start_download(next_record.object, next_record.chunk);
+	}
+
+	record_pending = false;
+	while ( trace->next(trace_id, next_record) )
+	{
+		if (next_record.object == 0 || next_record.object >= content_distribution::catalog.size() ||
+			next_record.chunk >= __size(next_record.object)
+		){
+			// The record is not compatible with the catalog (see the objects
+			// and file_size parameters)
+			trace_skipped++;
+			continue;
+		}
+
+		record_pending = true;
+		simtime_t t = trace_start + next_record.time * 1e-6;
+		scheduleAt( t < simTime() ? simTime() : t, arrival );
+		break;
+	}
+}
+//</aa>
+
 void client::resend_interest(name_t name,cnumber_t number, int toward){
     chunk_t chunk = 0;
     ccn_interest* interest = new ccn_interest("interest",CCN_I);
@@ -312,14 +610,6 @@ void client::handle_incoming_chunk (ccn_data *data_message)
 				<<name<<" but it is not waiting for it" <<endl;
 			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
 		}
-		
-
-		if (client_stats == 0)
-		{
-			std::stringstream ermsg; 
-			ermsg<<"The pointer client_stats points to 0. This is an error";
-			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-		}
 	#endif
 	//</aa>
 
@@ -336,11 +626,10 @@ void client::handle_incoming_chunk (ccn_data *data_message)
 	// <aa> Therefore, we compute statistics only for the most popular files </aa>
     if (name <= __file_bulk){
 
-        client_stats[name].avg_distance = 
-				( client_stats[name].tot_chunks*client_stats[name].avg_distance+data_message->getHops() )/
-				( client_stats[name].tot_chunks+1 );
-        client_stats[name].tot_chunks++;
-        client_stats[name].tot_downloads+=1./size;
+		//<aa> The average distance and the downloads of the file are derived 
+		// from the hop sum and the number of chunks </aa>
+        client_stats.at(name, HOPS_COUNTER) += data_message->getHops();
+        client_stats.at(name, CHUNKS_COUNTER)++;
 
     }
 
@@ -349,58 +638,69 @@ void client::handle_incoming_chunk (ccn_data *data_message)
 
     //-----------Handling downloads------
     //Handling the download list (TODO put this piece of code within a virtual method, in this way implementing new strategies should be direct).
-    pair< multimap<name_t, download>::iterator, multimap<name_t, download>::iterator > ii;
-    multimap<name_t, download>::iterator it; 
+	//<aa> The downloads of name are found in O(1) in the download table </aa>
+    download_list *downloads = current_downloads.find(name);
+    unsigned i = 0;
+    bool completed = false; //<aa>
 
-    ii = current_downloads.equal_range(name);
-    it = ii.first;
-
-    while (it != ii.second)
+    while (downloads != NULL && i < downloads->size() )
 	{
-        if ( it->second.chunk == chunk_num )
+		download &d = (*downloads)[i];
+		//<aa> The chunk may be any of the window. It was 
+		// if (it->second.chunk == chunk_num) </aa>
+        if ( d.chunk <= chunk_num && chunk_num < d.next && !(d.received >> (chunk_num - d.chunk) & 1) )
 		{
-            it->second.chunk++;
-            if (it->second.chunk< __size(name) )
+			//<aa> Slide the window over the chunks received in order
+			rtt_sample(d, chunk_num);
+			d.received |= (uint64_t) 1 << (chunk_num - d.chunk);
+			while (d.received & 1){
+				d.received >>= 1;
+				d.chunk++;
+			}
+			//</aa>
+            if (d.chunk< __size(name) )
 			{ 
-		    	it->second.last = simTime();
+		    	d.last = simTime();
 		    	//if the file is not yet completed send the next interest
-		    	send_interest(name, it->second.chunk, data_message->getTarget());
+				//<aa> i.e., the ones that enter the window </aa>
+				fill_window(name, d, data_message->getTarget() );
             }else{ 
 	        	//if the file is completed delete the entry from the pendent file list
-				simtime_t completion_time = simTime()-it->second.start;
+				simtime_t completion_time = simTime()-d.start;
 				avg_time = (tot_chunks * avg_time + completion_time ) * 1./( tot_chunks+1 );
-		    	if (current_downloads.count(name)==1)
-				{
-		    	    current_downloads.erase(name);
-		    	    break;
-		    	}else{
-		    	    current_downloads.erase(it++);
-		    	    continue;
-		    	}
+				//<aa>
+				completed_chunks += d.chunk - d.first;
+				completed_time += completion_time;
+				completion_histogram.record(completion_time.dbl() );
+				free_send_slots.push_back(d.slot);
+				download_completed(d, completion_time);
+				//</aa>
+				downloads->erase(i);
+				completed = true; //<aa>
+				continue;
 			}
         }
-        ++it;
+        ++i;
     }
+    if (downloads != NULL && downloads->size() == 0)
+		current_downloads.erase(name);
+	//<aa> The deadline of the completed download may be the next one </aa>
+	if (completed)
+		schedule_timer();
     tot_chunks++;
 
 
 }
 
 void client::clear_stat(){
-	#ifdef SEVERE_DEBUG
-		if (client_stats == 0)
-		{
-			std::stringstream ermsg; 
-			ermsg<<"The pointer client_stats points to 0. This is an error";
-			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-		}
-	#endif
-
-
     avg_distance = 0;
     avg_time = 0;
     tot_downloads = 0;
     tot_chunks = 0;
+	completed_chunks = 0; //<aa>
+	completed_time = 0; //<aa>
+	chunk_rtt_histogram.clear(); //<aa>
+	completion_histogram.clear(); //<aa>
 
     //<aa>
     #ifdef SEVERE_DEBUG
@@ -408,17 +708,7 @@ void client::clear_stat(){
     #endif
     //</aa>
 
-    delete [] client_stats;
-    client_stats = new client_stat_entry[__file_bulk+1];
-
-	#ifdef SEVERE_DEBUG
-		if (client_stats == 0)
-		{
-			std::stringstream ermsg; 
-			ermsg<<"The pointer client_stats points to 0. This is an error";
-			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-		}
-	#endif
+    client_stats.clear(); //<aa> It was reallocated </aa>
 }
 
 //<aa> Get functions
@@ -442,8 +732,10 @@ unsigned int client::get_interests_sent(){
 
 bool client::is_waiting_for(name_t name)
 {
-	multimap<name_t, download>::iterator it = current_downloads.find(name);
-	return it != current_downloads.end();
+	return current_downloads.find(name) != NULL;
 }
 #endif
 //</aa>
+
+// References
+// [icp] G. Carofiglio, M. Gallo, L. Muscariello, "ICP: Design and Evaluation of an Interest Control Protocol for Content-Centric Networking", IEEE INFOCOM NOMEN Workshop, 2012
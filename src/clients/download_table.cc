@@ -0,0 +1,153 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include "ccnsim.h"
+#include "download_table.h"
+
+#define DOWNLOAD_TABLE_INITIAL_BITS 4
+
+
+download_list::download_list(const download_list &other):n(0),more(NULL){
+	*this = other;
+}
+
+download_list &download_list::operator=(const download_list &other){
+	if (&other == this)
+		return *this;
+	n = other.n;
+	for (unsigned i = 0; i < DOWNLOAD_INLINE; i++)
+		first[i] = other.first[i];
+	delete more;
+	more = other.more != NULL ? new vector<download>(*other.more) : NULL;
+	return *this;
+}
+
+void download_list::push_back(const download &d){
+	if (n < DOWNLOAD_INLINE)
+		first[n] = d;
+	else {
+		if (more == NULL)
+			more = new vector<download>;
+		more->push_back(d);
+	}
+	n++;
+}
+
+void download_list::erase(unsigned i){
+	for (; i + 1 < n; i++)
+		(*this)[i] = (*this)[i + 1];
+	n--;
+	if (n >= DOWNLOAD_INLINE)
+		more->pop_back();
+}
+
+void download_list::clear(){
+	n = 0;
+	delete more;
+	more = NULL;
+}
+
+void download_list::swap(download_list &other){
+	std::swap(n, other.n);
+	for (unsigned i = 0; i < DOWNLOAD_INLINE; i++)
+		std::swap(first[i], other.first[i]);
+	std::swap(more, other.more);
+}
+
+
+download_table::download_table():bits(DOWNLOAD_TABLE_INITIAL_BITS),used(0){
+	slots.resize(1 << bits);
+}
+
+//Fibonacci hashing: consecutive names (the most popular ones) are spread
+//over the whole table
+unsigned download_table::home(name_t name) const{
+	return (uint32_t) (name * 2654435769U) >> (32 - bits);
+}
+
+unsigned download_table::lookup(name_t name) const{
+	unsigned mask = slots.size() - 1;
+	unsigned i = home(name);
+	while (slots[i].name != 0 && slots[i].name != name)
+		i = (i + 1) & mask;
+	return i;
+}
+
+download_list *download_table::find(name_t name){
+	unsigned i = lookup(name);
+	return slots[i].name == name ? &slots[i].downloads : NULL;
+}
+
+void download_table::insert(name_t name, const download &d){
+	unsigned i = lookup(name);
+	if (slots[i].name == 0){
+		if (2 * (used + 1) > slots.size() ){
+			grow();
+			i = lookup(name);
+		}
+		slots[i].name = name;
+		used++;
+	}
+	slots[i].downloads.push_back(d);
+}
+
+void download_table::erase(name_t name){
+	unsigned mask = slots.size() - 1;
+	unsigned i = lookup(name);
+	if (slots[i].name != name)
+		return;
+
+	slots[i].name = 0;
+	slots[i].downloads.clear();
+	used--;
+
+	//Shift back the entries of the cluster that can be reached from their
+	//home slot only through the freed slot
+	for (unsigned j = (i + 1) & mask; slots[j].name != 0; j = (j + 1) & mask){
+		unsigned h = home(slots[j].name);
+		if ( ((j - h) & mask) >= ((j - i) & mask) ){
+			std::swap(slots[i].name, slots[j].name);
+			slots[i].downloads.swap(slots[j].downloads);
+			i = j;
+		}
+	}
+}
+
+void download_table::grow(){
+	vector<entry> old;
+	old.swap(slots);
+	bits++;
+	slots.resize(1 << bits);
+
+	for (unsigned k = 0; k < old.size(); k++){
+		if (old[k].name == 0)
+			continue;
+		unsigned i = lookup(old[k].name);
+		slots[i].name = old[k].name;
+		slots[i].downloads.swap(old[k].downloads);
+	}
+}
+//</aa>
@@ -0,0 +1,97 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include "population_client.h"
+#include "error_handling.h"
+#include "results_sink.h"
+
+Register_Class(population_client);
+
+
+void population_client::initialize(){
+	users = par("users");
+	if (users == 0){
+		std::stringstream ermsg; 
+		ermsg<<"A population client must have at least one user";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	client::initialize();
+
+	if (is_active() ){
+		user_downloads.assign(users, 0);
+		user_time.assign(users, 0);
+	}
+}
+
+double population_client::arrival_rate(){
+	return users * client::arrival_rate();
+}
+
+void population_client::request_file(){
+	requesting_user = intrand(users);
+	client::request_file();
+}
+
+void population_client::download_completed(const download &d, simtime_t completion_time){
+	unsigned u = d.user % users;
+	user_downloads[u]++;
+	user_time[u] += completion_time.dbl();
+}
+
+void population_client::clear_stat(){
+	client::clear_stat();
+	user_downloads.assign(users, 0);
+	user_time.assign(users, 0);
+}
+
+void population_client::finish(){
+	client::finish();
+	if (!is_active() )
+		return;
+
+	//Users that completed at least one download, and the spread of the 
+	//average download time among them
+	unsigned active_users = 0;
+	uint32_t max_downloads = 0;
+	double max_avg_time = 0;
+	for (unsigned u = 0; u < users; u++){
+		if (user_downloads[u] == 0)
+			continue;
+		active_users++;
+		if (user_downloads[u] > max_downloads)
+			max_downloads = user_downloads[u];
+		if (user_time[u] / user_downloads[u] > max_avg_time)
+			max_avg_time = user_time[u] / user_downloads[u];
+	}
+
+	record_result(this, "active_users", getNodeIndex(), active_users);
+
+	record_result(this, "user_downloads_max", getNodeIndex(), max_downloads);
+
+	record_result(this, "user_avg_time_max", getNodeIndex(), max_avg_time);
+}
+//</aa>
@@ -0,0 +1,82 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <cmath>
+#include "ccnsim.h"
+#include "request_buffer.h"
+#include "content_distribution.h"
+
+static inline uint64_t rotl(uint64_t x, int k){
+	return (x << k) | (x >> (64 - k));
+}
+
+void request_buffer::initialize(uint64_t seed, unsigned block_, bool names_){
+	block = block_;
+	names = names_;
+
+	//The state is expanded from the seed by splitmix64, as recommended
+	for (unsigned i = 0; i < 4; i++){
+		uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		state[i] = z ^ (z >> 31);
+	}
+
+	gaps.resize(block);
+	uniforms.resize(block);
+	if (names)
+		drawn_names.resize(block);
+	next_gap_ = next_p = block; //Filled at the first use
+}
+
+double request_buffer::uniform(){
+	uint64_t result = rotl(state[1] * 5, 7) * 9;
+	uint64_t t = state[1] << 17;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+
+	//53 random bits, shifted by half a step to exclude 0
+	return ( (result >> 11) + 0.5) * (1. / 9007199254740992.);
+}
+
+void request_buffer::refill_gaps(){
+	for (unsigned i = 0; i < block; i++)
+		gaps[i] = -log(uniform() );
+	next_gap_ = 0;
+}
+
+void request_buffer::refill_popularity(){
+	for (unsigned i = 0; i < block; i++)
+		uniforms[i] = uniform();
+	if (names)
+		content_distribution::zipf.values(&uniforms[0], &drawn_names[0], block);
+	next_p = 0;
+}
+//</aa>
@@ -0,0 +1,233 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "trace_reader.h"
+#include "error_handling.h"
+
+//Number of records the kernel is asked to read ahead (and to drop once
+//consumed) at a time: 2^19 records, i.e. 10MB
+#define TRACE_WINDOW (1<<19)
+
+//Records queued at most for a subscriber, i.e. 20KB
+#define TRACE_QUEUE (1<<10)
+#define NO_RESUME ( (uint64_t) -1)
+
+map<string, trace_reader *> trace_reader::readers;
+
+
+trace_reader *trace_reader::open(const string &path){
+	map<string, trace_reader *>::iterator it = readers.find(path);
+	if (it != readers.end() ){
+		it->second->references++;
+		return it->second;
+	}
+	trace_reader *reader = new trace_reader(path);
+	readers[path] = reader;
+	return reader;
+}
+
+void trace_reader::release(trace_reader *reader){
+	if (--reader->references == 0){
+		readers.erase(reader->path);
+		delete reader;
+	}
+}
+
+trace_reader::trace_reader(const string &path_)
+	:path(path_),fd(-1),map_base(NULL),map_len(0),first(NULL),
+	 records(0),cursor(0),advised(0),counted(false),references(1)
+{
+	std::stringstream ermsg;
+
+	fd = ::open(path.c_str(), O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0){
+		ermsg<<"Impossible to open the trace file "<<path;
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	map_len = st.st_size;
+
+	if (map_len < sizeof(trace_header) ){
+		ermsg<<"File "<<path<<" is too short to be a trace";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	void *base = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (base == MAP_FAILED){
+		ermsg<<"Impossible to map the trace file "<<path;
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	map_base = (const char *) base;
+	madvise(base, map_len, MADV_SEQUENTIAL);
+
+	// INPUT_CHECK{
+	const trace_header *header = (const trace_header *) map_base;
+	if (memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic) ) != 0 ||
+		header->version != TRACE_VERSION ||
+		header->record_size != sizeof(trace_record)
+	){
+		ermsg<<"File "<<path<<" is not a trace of version "<<TRACE_VERSION<<
+			". Generate it with scripts/csv2trace.py";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	records = header->records;
+	if (sizeof(trace_header) + records * sizeof(trace_record) > map_len){
+		ermsg<<"The trace "<<path<<" should contain "<<records<<" records, but it is truncated";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	// }INPUT_CHECK
+
+	first = (const trace_record *) (map_base + sizeof(trace_header) );
+}
+
+trace_reader::~trace_reader(){
+	munmap( (void *) map_base, map_len);
+	close(fd);
+}
+
+unsigned trace_reader::subscribe(){
+	if (counted){
+		std::stringstream ermsg;
+		ermsg<<"A client subscribed to trace "<<path<<" after the replay started";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	pending.resize(pending.size() + 1);
+	resume.push_back(NO_RESUME);
+	remaining.push_back(0);
+	return pending.size() - 1;
+}
+
+//Drop the pages of the records before the given one
+void trace_reader::drop_before(uint64_t record){
+	long page = sysconf(_SC_PAGESIZE);
+	size_t len = ( (const char *) (first + record) - map_base) / page * page;
+	if (len > 0)
+		madvise( (void *) map_base, len, MADV_DONTNEED);
+}
+
+//First pass over the file, once all the clients subscribed: count the
+//records of each subscriber, a window at a time
+void trace_reader::count_records(){
+	unsigned subscribers = pending.size();
+	for (uint64_t from = 0; from < records; from += TRACE_WINDOW){
+		uint64_t to = from + TRACE_WINDOW < records ? from + TRACE_WINDOW : records;
+		for (uint64_t k = from; k < to; k++)
+			remaining[first[k].client % subscribers]++;
+		drop_before(to);
+	}
+	counted = true;
+	read_ahead();
+}
+
+//Prefetch the window following the cursor and drop the one preceding the
+//oldest record still to be read
+void trace_reader::read_ahead(){
+	long page = sysconf(_SC_PAGESIZE);
+
+	uint64_t oldest = cursor;
+	for (unsigned s = 0; s < resume.size(); s++)
+		if (resume[s] < oldest)
+			oldest = resume[s];
+	if (oldest >= TRACE_WINDOW)
+		drop_before(oldest - TRACE_WINDOW);
+
+	uint64_t window_end = cursor + TRACE_WINDOW < records ? cursor + TRACE_WINDOW : records;
+	const char *from = (const char *) (first + cursor);
+	const char *aligned = map_base + (from - map_base) / page * page;
+	madvise( (void *) aligned, (const char *) (first + window_end) - aligned, MADV_WILLNEED);
+	advised = window_end;
+}
+
+bool trace_reader::next(unsigned subscriber, trace_record &record){
+	if (!counted)
+		count_records();
+
+	if (remaining[subscriber] == 0)
+		//No need to go further in the file
+		return false;
+	remaining[subscriber]--;
+
+	deque<trace_record> &queue = pending[subscriber];
+	if (!queue.empty() ){
+		record = queue.front();
+		queue.pop_front();
+		return true;
+	}
+
+	if (resume[subscriber] != NO_RESUME && own_scan(subscriber, record) )
+		return true;
+
+	unsigned subscribers = pending.size();
+	while (cursor < records){
+		if (cursor >= advised)
+			read_ahead();
+
+		uint64_t position = cursor++;
+		const trace_record &r = first[position];
+		unsigned owner = r.client % subscribers;
+		if (owner == subscriber){
+			record = r;
+			return true;
+		}
+
+		if (resume[owner] != NO_RESUME)
+			//The owner will read it by itself
+			continue;
+		if (pending[owner].size() == TRACE_QUEUE){
+			resume[owner] = position;
+			continue;
+		}
+		pending[owner].push_back(r);
+	}
+
+	std::stringstream ermsg;
+	ermsg<<"The trace "<<path<<" ended before the last record of subscriber "<<subscriber;
+	severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	return false;
+}
+
+//After an overflow of its queue, the subscriber looks for its next record
+//between its resume position and the shared cursor
+bool trace_reader::own_scan(unsigned subscriber, trace_record &record){
+	unsigned subscribers = pending.size();
+	for (uint64_t p = resume[subscriber]; p < cursor; p++)
+		if (first[p].client % subscribers == subscriber){
+			record = first[p];
+			resume[subscriber] = p + 1;
+			return true;
+		}
+
+	//Back to the shared cursor
+	resume[subscriber] = NO_RESUME;
+	return false;
+}
+//</aa>
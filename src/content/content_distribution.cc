@@ -29,6 +29,7 @@
 
 //<aa>
 #include <error_handling.h>
+#include "memory_footprint.h" //<aa>
 //</aa>
 
 Register_Class(content_distribution);
@@ -36,6 +37,10 @@ Register_Class(content_distribution);
 
 vector<file> content_distribution::catalog;
 zipf_distribution  content_distribution::zipf;
+//<aa>
+shot_noise_distribution *content_distribution::snm = NULL;
+drift_ranking *content_distribution::popularity = NULL;
+//</aa>
 
 name_t  content_distribution::stabilization_bulk = 0;
 name_t  content_distribution::perfile_bulk = 0;
@@ -45,6 +50,10 @@ int  *content_distribution::repositories = 0;
 double  *content_distribution::repo_prices = 0;
 //</aa>
 int  *content_distribution::clients = 0;
+//<aa>
+vector<int> content_distribution::repo_lists;
+vector< pair<unsigned,unsigned> > content_distribution::repo_list_bounds;
+//</aa>
 int  *content_distribution::total_replicas_p;
 vector<double>  *content_distribution::repo_popularity_p;
 
@@ -94,6 +103,26 @@ void content_distribution::initialize(){
     stabilization_bulk = zipf.value(0.9);
     perfile_bulk = zipf.value(0.5);
 
+	//<aa>
+	//
+	//Request model initialization
+	//
+	string request_model = par("request_model").stdstringValue();
+	if (request_model.compare("snm") == 0){
+		snm = new shot_noise_distribution(getRNG(0), cardF, par("snm_birth_rate"),
+				par("snm_lifetime"), par("snm_volume_shape"),
+				par("snm_profile").stdstringValue() );
+	} else if (request_model.compare("drift") == 0){
+		// Initially, as in the irm, the content of rank i is the name i. The 
+		// popularity_drift module will then move the contents across the ranks
+		popularity = new drift_ranking();
+	} else if (request_model.compare("irm") != 0){
+        std::stringstream ermsg; 
+		ermsg<<"Request model \""<<request_model<<"\" incorrect. Valid models are irm, snm and drift";
+	    severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	//</aa>
+
 
     char name[15];
     //
@@ -138,9 +167,65 @@ void content_distribution::initialize(){
 
 	//<aa>
 	finalize_total_replica();
+	init_repo_lists();
+
+	// The SNM draws the size and the repositories of the born contents from
+	// the catalog: it can be started only now
+	if (snm != NULL)
+		snm->initialize( simTime().dbl() );
 	//</aa>
 }
 
+//<aa>
+name_t content_distribution::draw_name(double p){
+	if (snm != NULL)
+		return snm->value(simTime().dbl(), p);
+	//<aa> The weight of each rank never changes: the drift only moves the
+	// contents across the ranks </aa>
+	if (popularity != NULL)
+		return popularity->content(zipf.value(p) );
+	return zipf.value(p);
+}
+
+//The request models are static: the next run must not find them
+content_distribution::~content_distribution(){
+	delete snm;
+	snm = NULL;
+	delete popularity;
+	popularity = NULL;
+}
+//</aa>
+
+//<aa>
+//Intern the repository lists of the placements used in the catalog, so that 
+//the forwarding path does not have to decode (and allocate) them at each interest
+size_t content_distribution::catalog_footprint(){
+	return footprint(catalog) + footprint(repo_lists) + footprint(repo_list_bounds);
+}
+
+void content_distribution::init_repo_lists(){
+	repo_t max_repo = 0;
+	for (int d = 1; d <= cardF; d++)
+		if (__repo(d) > max_repo)
+			max_repo = __repo(d);
+
+	repo_lists.clear();
+	repo_list_bounds.assign(max_repo + 1, pair<unsigned,unsigned>(0,0) );
+	for (int d = 1; d <= cardF; d++){
+		repo_t repo = __repo(d);
+		pair<unsigned,unsigned> &bounds = repo_list_bounds[repo];
+		if (bounds.second != bounds.first)
+			continue; //Already interned
+
+		bounds.first = repo_lists.size();
+		for (int i = 0; repo; i++, repo >>= 1)
+			if (repo & 1) 
+				repo_lists.push_back(repositories[i]);
+		bounds.second = repo_lists.size();
+	}
+}
+//</aa>
+
 //<aa>
 void content_distribution::initialize_repo_popularity()
 {
@@ -0,0 +1,105 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include "fenwick_tree.h"
+
+fenwick_tree::fenwick_tree(unsigned n):log_size(0),updates(0){
+    resize(n);
+}
+
+void fenwick_tree::resize(unsigned n){
+    values.resize(n, 0);
+    log_size = 1;
+    while ( (log_size << 1) <= n )
+		log_size <<= 1;
+    rebuild();
+}
+
+//Build the tree in O(n) starting from the exact weights
+void fenwick_tree::rebuild(){
+    unsigned n = values.size();
+    tree.assign(n + 1, 0);
+    for (unsigned i = 1; i <= n; i++){
+		tree[i] += values[i-1];
+		unsigned j = i + (i & -i);
+		if (j <= n)
+			tree[j] += tree[i];
+    }
+    updates = 0;
+}
+
+void fenwick_tree::set(unsigned i, double w){
+    double delta = w - values[i];
+    values[i] = w;
+    if (++updates > 4 * values.size() ){
+		rebuild();
+		return;
+    }
+    for (unsigned j = i + 1; j < tree.size(); j += j & -j)
+		tree[j] += delta;
+}
+
+double fenwick_tree::prefix(unsigned i) const{
+    double s = 0;
+    for (unsigned j = i; j > 0; j -= j & -j)
+		s += tree[j];
+    return s;
+}
+
+double fenwick_tree::total() const{
+    return prefix(values.size() );
+}
+
+unsigned fenwick_tree::find(double u) const{
+    unsigned n = values.size();
+    unsigned pos = 0;
+    if (n == 0)
+		return 0;
+
+    //Descend the implicit tree: at each step pos is the largest index whose
+    //prefix sum does not exceed u
+    for (unsigned step = log_size; step > 0; step >>= 1){
+		if (pos + step <= n && tree[pos + step] <= u){
+			pos += step;
+			u -= tree[pos];
+		}
+    }
+
+    //Rounding errors may bring us on an element with null weight (or past
+    //the end): move to the nearest element that can actually be drawn
+    if (pos >= n)
+		pos = n - 1;
+    unsigned i = pos;
+    while (i < n && values[i] <= 0)
+		i++;
+    if (i == n){
+		i = pos;
+		while (i > 0 && values[i] <= 0)
+			i--;
+    }
+    return i;
+}
+//</aa>
@@ -0,0 +1,108 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include "popularity_drift.h"
+#include "content_distribution.h"
+#include "error_handling.h"
+#include "results_sink.h"
+
+Register_Class(popularity_drift);
+
+
+void popularity_drift::initialize(){
+	drift_timer = NULL;
+	events = 0;
+
+	// content_distribution is initialized before this module (see base.ned)
+	ranking = content_distribution::popularity;
+	if (ranking == NULL)
+		// The request model is not "drift"
+		return;
+
+	string drift_model = par("drift_model").stdstringValue();
+	period = par("drift_period");
+	swaps = par("drift_swaps");
+	int range = par("drift_range");
+	int objects = content_distribution::catalog.size() - 1;
+
+	// INPUT_CHECK{
+	if (drift_model.compare("shift") == 0)
+		shift = true;
+	else if (drift_model.compare("swap") == 0)
+		shift = false;
+	else {
+        std::stringstream ermsg; 
+		ermsg<<"Drift model \""<<drift_model<<"\" incorrect. Valid models are swap and shift";
+	    severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	if (period <= 0){
+        std::stringstream ermsg; 
+		ermsg<<"drift_period must be positive, while it is "<<period;
+	    severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	// }INPUT_CHECK
+
+	if (range <= 0 || range > objects)
+		range = objects;
+	ranking->resize(range);
+
+	drift_timer = new cMessage("drift", DRIFT);
+	scheduleAt(simTime() + period, drift_timer);
+}
+
+void popularity_drift::handleMessage(cMessage *in){
+	if (in->getKind() != DRIFT){
+        std::stringstream ermsg; 
+		ermsg<<"Unexpected message of kind "<<in->getKind();
+	    severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	bool changed = false;
+	if (shift){
+		ranking->rotate();
+		changed = ranking->size() > 1;
+	} else
+		for (unsigned i = 0; i < swaps; i++){
+			unsigned r1 = intrand(ranking->size() ), r2 = intrand(ranking->size() );
+			ranking->swap(r1, r2);
+			changed = changed || r1 != r2;
+		}
+
+	if (changed)
+		events++;
+	scheduleAt(simTime() + period, drift_timer);
+}
+
+void popularity_drift::finish(){
+	//Only when the ranking drifts
+	if (ranking != NULL)
+		record_result(this, "drift_events", -1, events);
+	if (drift_timer != NULL)
+		cancelAndDelete(drift_timer);
+	drift_timer = NULL;
+}
+//</aa>
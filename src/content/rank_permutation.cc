@@ -0,0 +1,75 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include "rank_permutation.h"
+
+//splitmix64 [splitmix] generator step, used to derive the round keys
+static uint64_t splitmix(uint64_t &state){
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+rank_permutation::rank_permutation(name_t F_, uint64_t key):F(F_){
+	half_bits = 1;
+	while ( (uint64_t) 1 << (2*half_bits) < F)
+		half_bits++;
+	half_mask = (1U << half_bits) - 1;
+
+	for (unsigned i = 0; i < FEISTEL_ROUNDS; i++)
+		round_keys[i] = (uint32_t) splitmix(key);
+}
+
+uint32_t rank_permutation::encrypt(uint32_t x) const{
+	uint32_t left = x >> half_bits;
+	uint32_t right = x & half_mask;
+
+	for (unsigned i = 0; i < FEISTEL_ROUNDS; i++){
+		//Round function: a 32 bit integer hash of the right half
+		uint32_t f = (right ^ round_keys[i]) * 0x45D9F3BU;
+		f ^= f >> 16;
+		f *= 0x45D9F3BU;
+		f ^= f >> 16;
+
+		uint32_t tmp = right;
+		right = left ^ (f & half_mask);
+		left = tmp;
+	}
+	return (left << half_bits) | right;
+}
+
+name_t rank_permutation::map(name_t rank) const{
+	uint32_t x = rank - 1;
+	do
+		x = encrypt(x);
+	while (x >= F);
+	return x + 1;
+}
+//</aa>
+
+// References
+// [splitmix] G. L. Steele, D. Lea, C. H. Flood, "Fast splittable pseudorandom number generators", OOPSLA 2014
@@ -0,0 +1,187 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <cmath>
+#include "shot_noise.h"
+#include "error_handling.h"
+
+//The exp profile is cut into SNM_EXP_STEPS constant steps, covering
+//SNM_EXP_HORIZON decay constants
+#define SNM_EXP_STEPS 8
+#define SNM_EXP_HORIZON 4
+
+//Contents born more than SNM_WARMUP mean lifetimes ago are (almost surely)
+//dead: the warm up does not need to go further in the past
+#define SNM_WARMUP 10
+
+
+shot_noise_distribution::shot_noise_distribution(cRNG *rng_, name_t F_,
+		double birth_rate_, double lifetime_, double volume_shape_, string profile)
+	:rng(rng_),F(F_),birth_rate(birth_rate_),lifetime(lifetime_),
+	 volume_shape(volume_shape_),alive(F_ + 1, false),next_birth(0),last_name(0),active(0)
+{
+	// INPUT_CHECK{
+	if (profile.compare("box") == 0)
+		exp_profile = false;
+	else if (profile.compare("exp") == 0)
+		exp_profile = true;
+	else {
+		std::stringstream ermsg;
+		ermsg<<"SNM profile \""<<profile<<"\" incorrect. Valid profiles are box and exp";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	if (birth_rate <= 0 || lifetime <= 0 || volume_shape <= 0){
+		std::stringstream ermsg;
+		ermsg<<"SNM parameters must be positive: birth_rate="<<birth_rate<<
+			"; lifetime="<<lifetime<<"; volume_shape="<<volume_shape;
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	double mean_active = birth_rate * lifetime * (exp_profile ? SNM_EXP_HORIZON : 1);
+	if (mean_active * 4 > F){
+		std::stringstream ermsg;
+		ermsg<<"On average "<<mean_active<<" contents are alive at the same time, "<<
+			"while the catalog has only "<<F<<" names. Births will often skip the names "<<
+			"still in use, and the simulation stops if they all are. Increase the number of objects";
+		debug_message(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	// }INPUT_CHECK
+}
+
+double shot_noise_distribution::exponential(double mean){
+	return -mean * log(1 - rng->doubleRand() );
+}
+
+void shot_noise_distribution::initialize(double now){
+	double warmup = SNM_WARMUP * lifetime * (exp_profile ? SNM_EXP_HORIZON : 1);
+
+	cout<<"Initializing SNM..."<<endl;
+	next_birth = now - warmup + exponential(1./birth_rate);
+	advance(now);
+	cout<<"SNM initialized with "<<active<<" active contents"<<endl;
+}
+
+//Rate of the content in slot during the given step of its profile
+double shot_noise_distribution::step_rate(unsigned slot, unsigned step){
+	if (!exp_profile)
+		return volumes[slot] / lifetimes[slot];
+
+	//Average of V*exp(-t/tau)/tau over the step
+	double d = SNM_EXP_HORIZON * 1./SNM_EXP_STEPS;
+	return volumes[slot] * ( exp(-d*step) - exp(-d*(step+1)) ) / (d * lifetimes[slot]);
+}
+
+void shot_noise_distribution::birth(double t){
+	unsigned slot;
+	if (!free_slots.empty() ){
+		slot = free_slots.back();
+		free_slots.pop_back();
+	} else {
+		slot = names.size();
+		names.push_back(0);
+		volumes.push_back(0);
+		lifetimes.push_back(0);
+		if (slot >= rates.size() )
+			rates.resize( slot < 16 ? 32 : 2*slot );
+	}
+
+	//Never reuse the name of a living content
+	if (active >= F){
+		std::stringstream ermsg;
+		ermsg<<"All the "<<F<<" names of the catalog are used by living contents at time "<<
+			t<<". Increase the number of objects";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	do
+		last_name = last_name % F + 1;
+	while (alive[last_name]);
+	alive[last_name] = true;
+	names[slot] = last_name;
+	volumes[slot] = pow(1 - rng->doubleRand(), -1./volume_shape); //Pareto with x_m=1
+	lifetimes[slot] = exponential(lifetime);
+	active++;
+
+	snm_event e;
+	e.time = t;
+	e.slot = slot;
+	e.step = 0;
+	process(e);
+}
+
+void shot_noise_distribution::process(const snm_event &e){
+	unsigned last_step = exp_profile ? SNM_EXP_STEPS : 1;
+
+	if (e.step == last_step){
+		//Death
+		rates.set(e.slot, 0);
+		alive[ names[e.slot] ] = false;
+		free_slots.push_back(e.slot);
+		active--;
+		return;
+	}
+
+	rates.set(e.slot, step_rate(e.slot, e.step) );
+
+	snm_event next = e;
+	next.step++;
+	next.time += exp_profile ?
+		lifetimes[e.slot] * SNM_EXP_HORIZON / SNM_EXP_STEPS : lifetimes[e.slot];
+	calendar.push(next);
+}
+
+//Process, in time order, all the births and calendar events up to now
+void shot_noise_distribution::advance(double now){
+	while (1){
+		bool pending_event = !calendar.empty() && calendar.top().time <= now;
+		if (next_birth <= now &&
+			(!pending_event || next_birth <= calendar.top().time)
+		){
+			double t = next_birth;
+			birth(t);
+			next_birth = t + exponential(1./birth_rate);
+		} else if (pending_event){
+			snm_event e = calendar.top();
+			calendar.pop();
+			process(e);
+		} else
+			break;
+	}
+}
+
+name_t shot_noise_distribution::value(double now, double p){
+	advance(now);
+
+	if (active == 0){
+		std::stringstream ermsg;
+		ermsg<<"No content is alive at time "<<now<<". Increase the SNM birth rate "<<
+			"or the content lifetime";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	return names[ rates.find(p * rates.total() ) ];
+}
+//</aa>
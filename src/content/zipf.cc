@@ -25,6 +25,8 @@
 #include "zipf.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include "memory_footprint.h" //<aa>
 
 using namespace std;
 
@@ -69,6 +71,14 @@ void zipf_distribution::zipf_initialize(){
 double zipf_distribution::get_normalization_constant(){
 	return normalization_constant;
 }
+
+double zipf_distribution::pmf(unsigned int i){
+	return normalization_constant / pow(i+q,alpha);
+}
+
+size_t zipf_distribution::memory_footprint(){
+	return footprint(cdfZipf) + footprint(guide);
+}
 //</aa>
 
 
@@ -100,3 +110,36 @@ unsigned int zipf_distribution::value(double p){
     return upper;
 
 }
+
+//<aa>
+//Inverse-CDF bucketing: guide[j] is the smallest rank whose cdf is >= j/B, so
+//that the rank of any p in [j/B, (j+1)/B) lies between guide[j] and guide[j+1]
+void zipf_distribution::guide_initialize(){
+	unsigned B = F / 4 + 1;
+	guide.resize(B + 1);
+	unsigned i = 1;
+	for (unsigned j = 0; j <= B; j++){
+		double x = (double) j / B;
+		while (i < (unsigned) F && cdfZipf[i] < x)
+			i++;
+		guide[j] = i;
+	}
+}
+
+void zipf_distribution::values(const double *p, unsigned int *out, unsigned n){
+	if (guide.empty() )
+		guide_initialize();
+
+	unsigned B = guide.size() - 1;
+	for (unsigned k = 0; k < n; k++){
+		unsigned j = min( (unsigned) (p[k] * B), B - 1);
+		// The bucket spans a few ranks on average, so the search is short
+		vector<double>::iterator lower = std::lower_bound(
+			cdfZipf.begin() + guide[j], cdfZipf.begin() + guide[j+1] + 1, p[k]);
+		// Because of rounding errors, the last value of the CDF may be < 1
+		if (lower == cdfZipf.end() )
+			lower--;
+		out[k] = lower - cdfZipf.begin();
+	}
+}
+//</aa>
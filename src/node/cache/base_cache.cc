@@ -26,6 +26,9 @@
 #include "base_cache.h"
 #include "core_layer.h"
 #include "statistics.h"
+#include "results_sink.h" //<aa>
+#include "content_sketch.h" //<aa>
+#include "profiler.h" //<aa>
 #include "content_distribution.h"
 #include "ccn_data_m.h"
 
@@ -56,6 +59,11 @@ void base_cache::initialize(){
 
 	decisor = NULL;
 
+	//<aa>
+	stats = (statistics *) simulation.getSystemModule()->getSubmodule("statistics");
+	full_notified = false;
+	//</aa>
+
     string decision_policy = par("DS");
 
     //Initialize the storage policy
@@ -143,7 +151,18 @@ void base_cache::initialize(){
 	//</aa>
 
     //--Per file
-    cache_stats = new cache_stat_entry[__file_bulk + 1];
+    cache_stats.resize(__file_bulk); //<aa> It was new cache_stat_entry[__file_bulk + 1] </aa>
+
+	//<aa>
+	int sketch_width = par("sketch_width");
+	sketch = NULL;
+	if (sketch_width > 0)
+		sketch = new content_sketch(sketch_width, par("sketch_depth"), par("sketch_top") );
+	//</aa>
+
+	//<aa> A cache that is already full (e.g. of size 0) would never
+	// notify it, as it may never store anything </aa>
+	check_full();
 
 	//<aa>
 	#ifdef SEVERE_DEBUG
@@ -155,38 +174,53 @@ void base_cache::initialize(){
 
 void base_cache::finish(){
     char name [30];
-    sprintf ( name, "p_hit[%d]", getIndex());
-    //Average hit rate
-    recordScalar (name, hit * 1./(hit+miss));
-
+	//<aa> The per node results go through record_result (see results_sink.h).
+	// They used to be recorded as sprintf(name, "p_hit[%d]", getIndex()) scalars </aa>
 
-    sprintf ( name, "hits[%d]", getIndex());
-    recordScalar (name, hit );
+    //Average hit rate
+    record_result(this, "p_hit", getIndex(), hit * 1./(hit+miss));
 
+    record_result(this, "hits", getIndex(), hit );
 
-    sprintf ( name, "misses[%d]", getIndex());
-    recordScalar (name, miss);
+    record_result(this, "misses", getIndex(), miss);
 
 	//<aa>
-    sprintf ( name, "decision_yes[%d]", getIndex());
-    recordScalar (name, decision_yes);
+    record_result(this, "decision_yes", getIndex(), decision_yes);
 
-    sprintf ( name, "decision_no[%d]", getIndex());
-    recordScalar (name, decision_no);
+    record_result(this, "decision_no", getIndex(), decision_no);
 
-    sprintf ( name, "decision_ratio[%d]", getIndex());
 	double decision_ratio = (decision_yes + decision_no == 0 ) ?
 			0 : (double)decision_yes / (decision_yes + decision_no) ; 
-    recordScalar (name, decision_ratio);
+    record_result(this, "decision_ratio", getIndex(), decision_ratio);
 
 	decisor->finish(getIndex(), this);
 	//</aa>
 
+	//<aa>
+	if (sketch != NULL){
+		record_sketch();
+		delete sketch;
+		sketch = NULL;
+	}
+	//</aa>
+
     //Per file hit rate
+	//<aa> In the results file, it is the p_hit of each file </aa>
+	if (results_sink::enabled() ){
+		for (uint32_t f = 1; f <= __file_bulk; f++){
+			uint32_t file_hit = cache_stats.get(f, HIT_COUNTER);
+			results_sink::add(getIndex(), f, "p_hit", file_hit * 1./(file_hit + cache_stats.get(f, MISS_COUNTER) ) );
+		}
+		return;
+	}
+
     sprintf ( name, "hit_node[%d]", getIndex());
     cOutVector hit_vector(name);
-    for (uint32_t f = 1; f <= __file_bulk; f++)
-        hit_vector.recordWithTimestamp(f, cache_stats[f].rate() );
+    for (uint32_t f = 1; f <= __file_bulk; f++){
+		//<aa> It was cache_stats[f].rate() </aa>
+		uint32_t file_hit = cache_stats.get(f, HIT_COUNTER);
+        hit_vector.recordWithTimestamp(f, file_hit * 1./(file_hit + cache_stats.get(f, MISS_COUNTER) ) );
+	}
 
 
 }
@@ -195,9 +229,11 @@ void base_cache::finish(){
 
 //Base class function: a data has been received:
 void base_cache::store(cMessage *in){
+	PROFILE_SCOPE(PROFILE_STORE, getIndex() ); //<aa>
     if (cache_size ==0){
 		//<aa>
 		decision_no++;
+		check_full();
 		//</aa>
 		return;
 	}
@@ -210,6 +246,7 @@ void base_cache::store(cMessage *in){
 
 		//<aa>
 		decisor->after_insertion_action();
+		check_full();
 		//</aa>
 	}
 	//<aa>
@@ -218,11 +255,76 @@ void base_cache::store(cMessage *in){
 
 }
 
+//<aa> Hit rate vs content name over the whole catalog, estimated by the 
+// sketch at 10 points per decade (with the static Zipf catalog, the name is
+// the popularity rank), and the most requested contents </aa>
+void base_cache::record_sketch(){
+	name_t objects = content_distribution::catalog.size() - 1;
+
+	vector<name_t> points;
+	for (unsigned k = 0; ; k++){
+		name_t f = (name_t) floor(pow(10, k / 10.) + 0.5);
+		if (f > objects)
+			break;
+		if (points.empty() || f != points.back() )
+			points.push_back(f);
+	}
+	vector<sketch_top_entry> top = sketch->top();
+
+	if (results_sink::enabled() ){
+		for (unsigned i = 0; i < points.size(); i++)
+			results_sink::add(getIndex(), points[i], "sketch_hit_node", sketch_rate(points[i]) );
+		for (unsigned i = 0; i < top.size(); i++){
+			results_sink::add(getIndex(), top[i].name, "top_requests", top[i].count);
+			//Hits are known only for the requests since the content is monitored
+			results_sink::add(getIndex(), top[i].name, "top_hit", top[i].hits * 1./(top[i].count - top[i].error) );
+		}
+		return;
+	}
+
+	char name [30];
+	sprintf ( name, "sketch_hit_node[%d]", getIndex());
+	cOutVector curve_vector(name);
+	for (unsigned i = 0; i < points.size(); i++)
+		curve_vector.recordWithTimestamp(points[i], sketch_rate(points[i]) );
+
+	sprintf ( name, "top_requests[%d]", getIndex());
+	cOutVector requests_vector(name);
+	sprintf ( name, "top_hit[%d]", getIndex());
+	cOutVector top_hit_vector(name);
+	for (unsigned i = 0; i < top.size(); i++){
+		requests_vector.recordWithTimestamp(top[i].name, top[i].count);
+		top_hit_vector.recordWithTimestamp(top[i].name, top[i].hits * 1./(top[i].count - top[i].error) );
+	}
+}
+
+size_t base_cache::stats_footprint(){
+	return cache_stats.memory_footprint() + (sketch != NULL ? sketch->memory_footprint() : 0);
+}
+
+double base_cache::sketch_rate(name_t f){
+	double h = sketch->hits(f), m = sketch->misses(f);
+	return h + m > 0 ? h / (h + m) : 0;
+}
+
+//<aa> The statistics module used to poll full() on every cache each ts 
+// seconds. The cache notifies it instead, at the first store that fills it.
+// A cache never gets emptied, so a single notification is enough.
+void base_cache::check_full(){
+	if (!full_notified && full() ){
+		full_notified = true;
+		if (stats != NULL)
+			stats->cache_full();
+	}
+}
+//</aa>
+
 
 
 //Base class function: lookup for a given data
 //it wraps statistics on misses and hits
 bool base_cache::lookup(chunk_t chunk ){
+	PROFILE_SCOPE(PROFILE_LOOKUP, getIndex() ); //<aa>
     bool found = false;
     name_t name = __id(chunk);
 
@@ -233,7 +335,11 @@ bool base_cache::lookup(chunk_t chunk ){
 
 	//Per file cache statistics(hit)
 	if (name <= __file_bulk)
-	    cache_stats[name].hit++;
+	    cache_stats.at(name, HIT_COUNTER)++;
+	//<aa>
+	if (sketch != NULL)
+		sketch->record(name, true);
+	//</aa>
 
     }else{
         found = false;
@@ -242,7 +348,11 @@ bool base_cache::lookup(chunk_t chunk ){
 		miss++;
 		//Per file cache statistics(miss)
 		if ( name <= __file_bulk )
-			cache_stats[name].miss++;
+			cache_stats.at(name, MISS_COUNTER)++;
+		//<aa>
+		if (sketch != NULL)
+			sketch->record(name, false);
+		//</aa>
     }
 
     return found;
@@ -263,8 +373,11 @@ void base_cache::clear_stat()
 	//<aa>
 	decision_yes = decision_no = 0;
 	//</aa>
-    delete cache_stats;
-    cache_stats = new cache_stat_entry[__file_bulk+1];
+    cache_stats.clear(); //<aa> It was reallocated (and released with a scalar delete) </aa>
+	//<aa>
+	if (sketch != NULL)
+		sketch->clear();
+	//</aa>
 }
 
 //<aa>
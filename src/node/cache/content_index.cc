@@ -0,0 +1,88 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <algorithm>
+#include "ccnsim.h"
+#include "content_index.h"
+#include "error_handling.h"
+#include "memory_footprint.h"
+
+boost::unordered_map<chunk_t, vector<int> > content_index::index;
+unsigned content_index::users = 0;
+
+
+void content_index::subscribe(){
+	users++;
+}
+
+void content_index::release(){
+	if (users > 0 && --users == 0)
+		index.clear();
+}
+
+void content_index::insert(chunk_t chunk, int node){
+	vector<int> &nodes = index[chunk];
+	#ifdef SEVERE_DEBUG
+	if (std::find(nodes.begin(), nodes.end(), node) != nodes.end() ){
+		std::stringstream ermsg; 
+		ermsg<<"Node "<<node<<" stored chunk "<<chunk<<" twice in the content index";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	#endif
+	nodes.push_back(node);
+}
+
+void content_index::erase(chunk_t chunk, int node){
+	boost::unordered_map<chunk_t, vector<int> >::iterator it = index.find(chunk);
+	if (it != index.end() ){
+		vector<int> &nodes = it->second;
+		vector<int>::iterator n = std::find(nodes.begin(), nodes.end(), node);
+		if (n != nodes.end() ){
+			*n = nodes.back();
+			nodes.pop_back();
+			if (nodes.empty() )
+				index.erase(it);
+			return;
+		}
+	}
+	std::stringstream ermsg; 
+	ermsg<<"Node "<<node<<" evicted chunk "<<chunk<<", which is not in the content index";
+	severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+}
+
+const vector<int> *content_index::holders(chunk_t chunk){
+	boost::unordered_map<chunk_t, vector<int> >::const_iterator it = index.find(chunk);
+	return it != index.end() ? &it->second : NULL;
+}
+
+size_t content_index::memory_footprint(){
+	size_t bytes = footprint(index);
+	for (boost::unordered_map<chunk_t, vector<int> >::const_iterator it = index.begin(); 
+		it != index.end(); it++)
+		bytes += footprint(it->second);
+	return bytes;
+}
+//</aa>
@@ -28,14 +28,17 @@ Register_Class(fifo_cache);
 
 void fifo_cache::data_store(chunk_t chunk){
 
-   cache[chunk] = true;
+   //<aa> The chunk may already be in the cache (and then twice in deq) </aa>
+   if (cache.insert(make_pair(chunk, true) ).second)
+       index_insert(chunk); //<aa>
    deq.push_back(chunk);
 
    if ( deq.size() > get_size() ) {
    //Eviction of the last element
        chunk_t toErase = deq.front();
        deq.pop_front();
-       cache.erase(toErase);
+       if (cache.erase(toErase) )
+           index_erase(toErase); //<aa>
    }
 
 }
@@ -49,3 +52,9 @@ bool fifo_cache::data_lookup(chunk_t chunk){
 bool fifo_cache::full(){
     return (cache.size() == get_size());
 }
+
+//<aa>
+size_t fifo_cache::index_footprint(){
+	return footprint(deq) + footprint(cache);
+}
+//</aa>
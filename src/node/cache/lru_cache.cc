@@ -53,6 +53,7 @@ void lru_cache::data_store(chunk_t elem){
         actual_size++;
         lru = mru = p;
         cache[elem] = p;
+        index_insert(elem); //<aa>
         return;
     } 
 
@@ -75,11 +76,13 @@ void lru_cache::data_store(chunk_t elem){
 
         free(tmp);
         cache.erase(k); //erase from the cache the most unused element
+        index_erase(k); //<aa>
     }else
         //otherwise do nothing, just update the actual_size of the cache
         actual_size++;
 
     cache[elem] = p; //store the new element together with its position
+    index_insert(elem); //<aa>
 
 
 }
@@ -172,3 +175,9 @@ void lru_cache::dump(){
 bool lru_cache::full(){
     return (actual_size==get_size());
 }
+
+//<aa>
+size_t lru_cache::index_footprint(){
+	return footprint(cache) + actual_size * heap_block(sizeof(lru_pos) );
+}
+//</aa>
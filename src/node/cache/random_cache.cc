@@ -32,14 +32,17 @@ void random_cache::initialize(){
 }
 
 void random_cache::data_store(chunk_t chunk){
-    cache[chunk] = true;
+    //<aa> The chunk may already be in the cache (and then twice in deq) </aa>
+    if (cache.insert(make_pair(chunk, true) ).second)
+        index_insert(chunk); //<aa>
     if (deq.size() == get_size() ){
         //Replacing a random element
         unsigned int pos = intrand(  deq.size() );
         chunk_t toErase = deq.at(pos);
 
         deq.at(pos) = chunk;
-        cache.erase(toErase);
+        if (cache.erase(toErase) )
+            index_erase(toErase); //<aa>
 
     } else
         deq.push_back(chunk);
@@ -66,7 +69,8 @@ bool random_cache::warmup(){
     cout<<"Starting warmup..."<<endl;
     for (int i = k*C+1; i<=(k+1)*C; i++){
 	__sid(chunk,i);
-	cache[chunk] = true;
+	if (cache.insert(make_pair(chunk, true) ).second)
+	    index_insert(chunk); //<aa>
 	//cout<<"cache index "<<k<<" storing "<<i<<endl;
 	//deq.push_back(chunk);
     }
@@ -100,3 +104,9 @@ bool random_cache::warmup(){
 
 
 }
+
+//<aa>
+size_t random_cache::index_footprint(){
+	return footprint(deq) + footprint(cache);
+}
+//</aa>
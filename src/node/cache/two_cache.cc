@@ -28,7 +28,9 @@ Register_Class(two_cache);
 
 void two_cache::data_store(chunk_t chunk){
 
-   cache[chunk] = true;
+   //<aa> The chunk may already be in the cache (and then twice in deq) </aa>
+   if (cache.insert(make_pair(chunk, true) ).second)
+       index_insert(chunk); //<aa>
 
    if (deq.size() == get_size()){
 
@@ -66,7 +68,8 @@ void two_cache::data_store(chunk_t chunk){
 
        //Erase the more popular elements among the two
        deq.at(pos)=chunk;
-       cache.erase(toErase);
+       if (cache.erase(toErase) )
+           index_erase(toErase); //<aa>
    }else
        deq.push_back(chunk);
 
@@ -81,3 +84,9 @@ bool two_cache::data_lookup(chunk_t chunk){
 bool two_cache::full(){
     return (deq.size()==get_size());
 }
+
+//<aa>
+size_t two_cache::index_footprint(){
+	return footprint(deq) + footprint(cache);
+}
+//</aa>
@@ -34,6 +34,10 @@
 
 //<aa>
 #include "error_handling.h"
+#include "results_sink.h"
+#include "profiler.h"
+#include "memory_footprint.h"
+#include "statistics.h"
 //</aa>
 
 Register_Class(core_layer);
@@ -55,8 +59,13 @@ void  core_layer::initialize(){
 	//<aa>
 	#ifdef SEVERE_DEBUG
 		is_it_initialized = false;
-		it_has_a_repo_attached = false;
 	#endif
+	it_has_a_repo_attached = false;
+
+	//Sampled invariant checks (never with check_every == 0)
+	check_every = par("check_every").longValue();
+	check_countdown = check_every;
+	sampled_checks = 0;
 	//</aa>
 
     int i = 0;
@@ -65,9 +74,7 @@ void  core_layer::initialize(){
 	{
 		if (content_distribution::repositories[i] == getIndex() ){
 			//<aa>
-			#ifdef SEVERE_DEBUG
-				it_has_a_repo_attached = true;
-			#endif
+			it_has_a_repo_attached = true;
 
 			repo_price = content_distribution::repo_prices[i]; 
 			//</aa>
@@ -81,6 +88,19 @@ void  core_layer::initialize(){
     ContentStore = (base_cache *) gate("cache_port$o")->getNextGate()->getOwner();
     strategy = (strategy_layer *) gate("strategy_port$o")->getNextGate()->getOwner();
 
+	//<aa> The links toward the other nodes are registered to the statistics
+	// module, that will report the traffic counted on their faces </aa>
+	interest_size = par("interest_size");
+	chunk_size = par("chunk_size");
+	face_stats.resize(gateSize("face$o") );
+	statistics *stats = (statistics *) simulation.getSystemModule()->getSubmodule("statistics");
+	for (int f = 0; f < __get_outer_interfaces(); f++){
+		cChannel *channel = getParentModule()->gate("face$o", f)->getChannel();
+		if (stats != NULL && channel != NULL && !__check_client(f) )
+			stats->registerIcnChannel(channel);
+	}
+	//</aa>
+
     //Statistics
     //interests = 0; //<aa> Disabled this. The reset is inside clear_stat() </aa>
     //data = 0; //<aa> Disabled this. The reset is inside clear_stat() </aa>
@@ -117,9 +137,18 @@ void  core_layer::initialize(){
  */
 void core_layer::handleMessage(cMessage *in){
 	//<aa>
+	PROFILE_SCOPE(PROFILE_CORE, getIndex() );
 	#ifdef SEVERE_DEBUG
 	check_if_correct(__LINE__);
 	char* last_received;
+	#else
+	// The same invariants, on 1 event out of check_every. The branch is
+	// almost never taken: it costs a test (and a decrement if enabled)
+	if (__builtin_expect(check_every != 0 && --check_countdown == 0, 0) ){
+		check_countdown = check_every;
+		sampled_checks++;
+		check_if_correct(__LINE__);
+	}
 	#endif
 	//</aa>
 
@@ -144,8 +173,8 @@ void core_layer::handleMessage(cMessage *in){
 		if (int_msg->getHops() == int_msg->getTTL())
 		{
 	    	//<aa>
-	    	#ifdef SEVERE_DEBUG
 	    	discarded_interests++;
+	    	#ifdef SEVERE_DEBUG
 	    	check_if_correct(__LINE__);
 	    	#endif
 	    	//</aa>
@@ -201,29 +230,30 @@ void core_layer::finish(){
 	#endif
 	//</aa>
 
-    char name [30];
+	//<aa> The per node results go through record_result (see results_sink.h) </aa>
 
     //Total interests
 	// <aa> Parts of these interests will be satisfied by the local cache; the remaining part will be sent to the local repo (if present) and partly sarisfied there. For the remaining part, a FIB entry will be searched to forward the intereset. If no FIB entry is found, the interest will be discarded </aa>
-    sprintf ( name, "interests[%d]", getIndex());
-    recordScalar (name, interests);
+    record_result(this, "interests", getIndex(), interests);
 
     if (repo_load != 0){
-		sprintf ( name, "repo_load[%d]", getIndex());
-		recordScalar(name,repo_load);
+		record_result(this, "repo_load", getIndex(), repo_load);
     }
 
     //Total data
-    sprintf ( name, "data[%d]", getIndex());
-    recordScalar (name, data);
+    record_result(this, "data", getIndex(), data);
 
 	//<aa> Interests sent to the repository attached to this node</aa>
     if (repo_interest != 0){
-	sprintf ( name, "repo_int[%d]", getIndex());
-	recordScalar(name, repo_interest);
+	record_result(this, "repo_int", getIndex(), repo_interest);
 	repo_interest = 0;
     }
 
+	//<aa>
+    if (check_every > 0)
+	record_result(this, "sampled_checks", getIndex(), sampled_checks);
+	//</aa>
+
 
 }
 
@@ -274,8 +304,8 @@ void core_layer::handle_interest(ccn_interest *int_msg)
         send_data(data_msg,"face$o", int_msg->getArrivalGate()->getIndex(), __LINE__); 
         
         //<aa>
-        #ifdef SEVERE_DEBUG
         interests_satisfied_by_cache++;
+        #ifdef SEVERE_DEBUG
 		check_if_correct(__LINE__);
         #endif
         //</aa>
@@ -321,8 +351,8 @@ void core_layer::handle_interest(ccn_interest *int_msg)
         //
         
    		//<aa>
-		#ifdef SEVERE_DEBUG
 		unsatisfied_interests++;
+		#ifdef SEVERE_DEBUG
 		check_if_correct(__LINE__);
 		#endif
 		//</aa>
@@ -371,7 +401,11 @@ void core_layer::handle_interest(ccn_interest *int_msg)
 			i_will_forward_interest = true;
 
 		if (i_will_forward_interest)
-		{  	bool * decision = strategy->get_decision(int_msg);
+		{  	bool * decision;
+			{
+				PROFILE_SCOPE(PROFILE_STRATEGY, getIndex() ); //<aa>
+				decision = strategy->get_decision(int_msg);
+			}
 	    	handle_decision(decision,int_msg);
 	    	delete [] decision;//free memory for the decision array
 		}
@@ -452,9 +486,7 @@ void core_layer::handle_data(ccn_data *data_msg)
     } 
 	//<aa> 
 	// Otherwise the data are unrequested
-	#ifdef SEVERE_DEBUG
-		else unsolicited_data++;
-	#endif
+	else unsolicited_data++;
 
 
     PIT.erase(chunk); //erase pending interests for that data file
@@ -498,6 +530,10 @@ void core_layer::handle_decision(bool* decision,ccn_interest *interest){
 			//&& interest->getArrivalGate()->getIndex() != i
 		){
 			sendDelayed(interest->dup(),interest->getDelay(),"face$o",i);
+			//<aa>
+			face_stats[i].interests++;
+			face_stats[i].bytes += interest_size;
+			//</aa>
 			#ifdef SEVERE_DEBUG
 			interest_has_been_forwarded = true;
 			#endif
@@ -574,22 +610,23 @@ void core_layer::clear_stat(){
     //<aa>
     repo_interest = 0;
     repo_load = 0;
+	fill(face_stats.begin(), face_stats.end(), face_counters() );
 	ContentStore->set_decision_yes(0);
 	ContentStore->set_decision_no(0);
 
     
-   	#ifdef SEVERE_DEBUG
 	unsolicited_data = 0;
 	discarded_interests = 0;
 	unsatisfied_interests = 0;
 	interests_satisfied_by_cache = 0;
+   	#ifdef SEVERE_DEBUG
 	check_if_correct(__LINE__);
 	#endif
     //</aa>
 }
 
-//<aa>
-#ifdef SEVERE_DEBUG
+//<aa> Always compiled: it is called at every step with SEVERE_DEBUG and on
+// a sample of the events otherwise (see check_every)
 void core_layer::check_if_correct(int line)
 {
 	if (repo_load != interests - discarded_interests - unsatisfied_interests
@@ -627,10 +664,17 @@ void core_layer::check_if_correct(int line)
 					severe_error(__FILE__,line,ermsg.str().c_str() );
 	}
 } //end of check_if_correct(..)
-#endif
 //</aa>
 
 //<aa>
+size_t core_layer::pit_footprint(){
+	size_t bytes = footprint(PIT);
+	for (boost::unordered_map<chunk_t, pit_entry>::iterator it = PIT.begin(); it != PIT.end(); ++it)
+		bytes += footprint(it->second.nonces);
+	return bytes;
+}
+//</aa>
+
 double core_layer::get_repo_price()
 {
 	#ifdef SEVERE_DEBUG
@@ -738,6 +782,9 @@ int	core_layer::send_data(ccn_data* msg, const char *gatename, int gateindex, in
 		}
 	}
 	#endif
+
+	face_stats[gateindex].data++;
+	face_stats[gateindex].bytes += chunk_size;
 	return send (msg, gatename, gateindex);
 }
 //</aa>
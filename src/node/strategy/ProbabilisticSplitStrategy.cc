@@ -140,7 +140,7 @@ int ProbabilisticSplitStrategy::decide_target_repository(ccn_interest *interest)
     {
     	// Get all the repositories that store the content demanded by the
     	// interest
-		vector<int> repos = interest->get_repos();
+		repo_view repos = interest->get_repos();
 		
 		// Choose one of them
 		repository = repos[intrand(repos.size())];
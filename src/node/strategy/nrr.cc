@@ -24,11 +24,14 @@
  */
 #include <omnetpp.h>
 #include <algorithm>
+#include <climits>
 #include "nrr.h"
 #include "ccnsim.h"
 #include "ccn_interest.h"
 #include "base_cache.h"
 #include "error_handling.h"
+#include "memory_footprint.h" //<aa>
+#include "content_index.h" //<aa>
 
 Register_Class(nrr);
 
@@ -38,12 +41,6 @@ struct lookup{
     bool operator() (Centry c) const { return c.cache->fake_lookup(elem); }
 };
 
-struct lookup_len{
-    chunk_t elem;
-    int len;
-    lookup_len(chunk_t e,int l):elem(e),len(l){;}
-    bool operator() (Centry c) const { return c.cache->fake_lookup(elem) && c.len ==len; }
-};
 
 
 void nrr::initialize(){
@@ -72,8 +69,45 @@ void nrr::initialize(){
     */
     
     sort(cfib.begin(), cfib.end());
+
+	//<aa> The caches are explored through the content index </aa>
+	cfib_position.assign(topo.getNumNodes(), -1);
+	for (unsigned p = 0; p < cfib.size(); p++)
+		cfib_position[cfib[p].cache->getIndex()] = p;
+	content_index::subscribe();
+	//</aa>
 }
 
+//<aa>
+nrr::~nrr(){
+	content_index::release();
+}
+
+// The holders of the chunk are taken from the content index. The result
+// is the one of scanning cfib with fake_lookup, without probing the caches
+void nrr::nearest_holders(chunk_t chunk, vector<int> &positions){
+	positions.clear();
+	const vector<int> *holders = content_index::holders(chunk);
+	if (holders == NULL)
+		return;
+
+	int min_len = INT_MAX;
+	for (vector<int>::const_iterator h = holders->begin(); h != holders->end(); h++){
+		int p = cfib_position[*h];
+		if (p < 0) continue; // this node, or out of range
+
+		if (cfib[p].len < min_len){
+			min_len = cfib[p].len;
+			positions.clear();
+		}
+		if (cfib[p].len == min_len)
+			positions.push_back(p);
+	}
+	// The random choice among the holders must see them in the cfib order
+	sort(positions.begin(), positions.end() );
+}
+//</aa>
+
 bool *nrr::get_decision(cMessage *in){
 
     bool *decision;
@@ -93,8 +127,7 @@ bool *nrr::exploit(ccn_interest *interest){
     int repository,
 	node,
 	output_iface,
-	gsize,
-	times;
+	gsize;
 
 	output_iface = -1;
 
@@ -104,8 +137,6 @@ bool *nrr::exploit(ccn_interest *interest){
 
 	//<aa>
 	#ifdef SEVERE_DEBUG
-		vector<Centry>::iterator node_it; // This iterator will point to the target node
-
 //		if (interest->getChunk() == 243 && interest->getOrigin()==0)
 //		{
 //			std::stringstream ermsg; 
@@ -126,119 +157,53 @@ bool *nrr::exploit(ccn_interest *interest){
 		//<aa> The target of the interest is this node </aa>
 
 	){
-	    //find the first occurrence in the sorted vector of caches.
-		vector<Centry>::iterator it = 
-			std::find_if (cfib.begin(),cfib.end(),lookup(interest->getChunk()) );
+		//<aa> It was a find_if over cfib, followed by a second scan of the
+		// caches at the same distance </aa>
+		vector<int> positions;
+		nearest_holders(interest->getChunk(), positions);
 
-		vector<int> repos = interest->get_repos();
+		repo_view repos = interest->get_repos();
 		repository = nearest(repos);
 
 		//<aa>
 		const int_f FIB_entry = get_FIB_entry(repository);
 		//</aa>
 
-		if (it!=cfib.end() && it->len <= FIB_entry.len+1)
+		if (!positions.empty() && cfib[positions[0]].len <= FIB_entry.len+1)
 		{//found!!!
 			//<aa>	It is possible to reach the content through the interface indicated
-			//		by 'it'. Moreover, this path is shorter than the path related to
-			//		the FIB_entry </aa>
-
+			//		by the nearest holders. Moreover, this path is shorter than the 
+			//		path related to the FIB_entry </aa>
 
 			//<aa>
-			vector<int> potential_targets;
-			int select;
-
-			// Compute target node: dummy way
-			{
-				#ifdef SEVERE_DEBUG
-					vector< vector<Centry>::iterator > potential_targets_it;
-				#endif
-				// Take all the targets with minimum distance and randomly choose one of them
-				for (vector<Centry>::iterator it2 = cfib.begin(); 
-					it2 != cfib.end() && it2->len <= it->len;
-					it2++
-				){
-						if (it2->cache->fake_lookup(interest->getChunk() ) )
-						{	potential_targets.push_back( it2->cache->getIndex() );
-							#ifdef SEVERE_DEBUG
-								if (it2->len < it->len){
-									std::stringstream ermsg; 
-									ermsg<<"I am node "<<getIndex()<<". ERROR ";
-									severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-								}
-								potential_targets_it.push_back(it2);
-							#endif
-						}
-				}
-				select = intrand(potential_targets.size() );			
-				node = potential_targets[select];
-				#ifdef SEVERE_DEBUG
-					node_it = potential_targets_it[select];
-				#endif
-			}
-
+			// Take all the targets with minimum distance and randomly choose one of them
+			int select = intrand(positions.size() );
+			node = cfib[positions[select]].cache->getIndex();
 
-			//<aa>
-			// The previous block of code replace :
-			// Compute target node: efficient way
-			if (false) //This is the old code. It is more efficient but it has some problem
-			{
-				times = std::count_if (cfib.begin(),cfib.end(),
-						lookup_len(interest->getChunk(),it->len) );
-				int select = intrand(times);
-				it+=select;
-				// node = it->cache->getIndex();
-
-				#ifdef SEVERE_DEBUG
-				if ( it->cache->fake_lookup(interest->getChunk() ) == false )
-				{
+			#ifdef SEVERE_DEBUG
+				// The index must give the holders found by scanning the caches
+				vector<Centry>::iterator it = 
+					std::find_if (cfib.begin(),cfib.end(),lookup(interest->getChunk()) );
+				vector<int> scanned;
+				for (vector<Centry>::iterator it2 = it; 
+					it2 != cfib.end() && it2->len <= it->len; it2++
+				)
+					if (it2->cache->fake_lookup(interest->getChunk() ) )
+						scanned.push_back(it2 - cfib.begin() );
+
+				if (scanned != positions){
 					std::stringstream ermsg; 
-					ermsg<<"I am node "<<getIndex()<<". I set node "<<
-						 node <<" as target for chunk "<<interest->getChunk() <<
-						". Serial number="<<interest->getSerialNumber()<<
-						". But node "<< 
-						node<<" does not contain that chunk."<<
-						times<<" nodes are holding the chunk in question.";
+					ermsg<<"I am node "<<getIndex()<<". The content index gives "<<
+						positions.size()<<" nearest holders of chunk "<<interest->getChunk()<<
+						" while "<<scanned.size()<<" caches at the same distance hold it";
 					severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
 				}
-				#endif
-			}
-			//</aa>
+			#endif
 
-			//<aa> Slightly modified
 			output_iface = get_FIB_entry(node).id;
-			//</aa>
 			interest->setTarget(node);
 
-			//<aa>
 			#ifdef SEVERE_DEBUG
-				times = std::count_if (cfib.begin(),cfib.end(),
-						lookup_len(interest->getChunk(),it->len) );
-				if (times == 1){
-					// The node calculated above should be obtained also as follows
-					int select = intrand(times);
-					it+=select;
-					int node_verification = it->cache->getIndex();
-					if (node_verification != node){
-						std::stringstream ermsg; 
-						ermsg<<"I am node "<<getIndex()<<". node="<< node <<
-							"; node_verification="<<node_verification<<
-							". They must be the same.";
-						severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-					}
-				}
-
-				if ( node_it->cache->fake_lookup(interest->getChunk() ) == false ){
-					std::stringstream ermsg; 
-					ermsg<<"I am node "<<getIndex()<<". I set node "<<
-						 node <<" as target for chunk "<<interest->getChunk() <<
-						". Serial number="<<interest->getSerialNumber()<<
-						". But node "<< 
-						node<<" does not contain that chunk."<<
-						times<<" nodes are holding the chunk in question.";
-					severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
-				}
-
 				if ( output_iface != get_FIB_entry(interest->getTarget() ).id )
 				{
 					std::stringstream ermsg; 
@@ -264,7 +229,7 @@ bool *nrr::exploit(ccn_interest *interest){
 	//<aa>
 	else if (interest->getTarget() == getIndex() )
 	{
-		vector<int> repos = interest->get_repos();
+		repo_view repos = interest->get_repos();
 		repository = nearest(repos);
 		const int_f FIB_entry = get_FIB_entry(repository);
 
@@ -308,14 +273,14 @@ bool *nrr::exploit(ccn_interest *interest){
     return decision;
 }
 
-int nrr::nearest(vector<int>& repositories){
+int nrr::nearest(const repo_view& repositories){
     int  min_len = 10000;
     vector<int> targets
 	//<aa>
 			(0);
 	//</aa>
 
-    for (vector<int>::iterator i = repositories.begin(); i!=repositories.end();i++){ 		//Find the shortest (the minimum)
+    for (repo_view::const_iterator i = repositories.begin(); i!=repositories.end();i++){ 		//Find the shortest (the minimum)
     	//<aa>
     	const int_f FIB_entry = get_FIB_entry(*i);
     	//</aa>
@@ -346,3 +311,8 @@ void nrr::finish(){
     //string id = "nodegetIndex()+"]";
 }
 
+//<aa> The FIB, plus the routes toward the caches and the state of the 
+// exploration </aa>
+size_t nrr::fib_footprint(){
+	return strategy_layer::fib_footprint() + footprint(dynFIB) + footprint(ghost_list) + footprint(cfib);
+}
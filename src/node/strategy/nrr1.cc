@@ -118,7 +118,7 @@ bool *nrr1::exploit_nearest(ccn_interest *interest){
 
     gsize = __get_outer_interfaces();
 
-    vector<int> repos = interest->get_repos();
+    repo_view repos = interest->get_repos();
     repository = nearest(repos);
 
 	//<aa>
@@ -135,11 +135,11 @@ bool *nrr1::exploit_nearest(ccn_interest *interest){
 
 }
 
-int nrr1::nearest(vector<int>& repositories){
+int nrr1::nearest(const repo_view& repositories){
     int  min_len = 10000;
     vector<int> targets;
 
-    for (vector<int>::iterator i = repositories.begin(); i!=repositories.end();i++){ 	//Find the shortest (the minimum)
+    for (repo_view::const_iterator i = repositories.begin(); i!=repositories.end();i++){ 	//Find the shortest (the minimum)
     	//<aa>
     	const int_f FIB_entry = get_FIB_entry(*i);
     	//</aa>
@@ -50,8 +50,8 @@ bool *parallel_repository::exploit(ccn_interest *interest){
     bool *decision = new bool[gsize];
     std::fill(decision,decision+gsize,0);
 
-    vector<int> repos = (interest->get_repos());
-    for (vector<int>::iterator it = repos.begin(); it!=repos.end();it++){
+    repo_view repos = interest->get_repos();
+    for (repo_view::const_iterator it = repos.begin(); it!=repos.end();it++){
     
     //<aa>
     const int_f FIB_entry = get_FIB_entry(*it);
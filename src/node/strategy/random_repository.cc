@@ -54,7 +54,7 @@ bool *random_repository::exploit(ccn_interest *interest){
 		severe_error(__FILE__, __LINE__, "Leva il fatto dell'1");
     	//<aa> Get all the repositories that store the content demanded by the
     	// interest </aa>
-		vector<int> repos = interest->get_repos();
+		repo_view repos = interest->get_repos();
 		
 		//<aa> Choose one of them </aa>
 		repository = random(repos);
@@ -75,6 +75,6 @@ bool *random_repository::exploit(ccn_interest *interest){
 }
 
 
-int random_repository::random(vector<int>& repositories){
+int random_repository::random(const repo_view& repositories){
     return repositories[intrand(repositories.size())];
 }
@@ -56,7 +56,7 @@ bool *spr::exploit(ccn_interest *interest){
 
     gsize = __get_outer_interfaces();
 
-    vector<int> repos = interest->get_repos();
+    repo_view repos = interest->get_repos();
     repository = nearest(repos);
 
 	//<aa>
@@ -73,7 +73,7 @@ bool *spr::exploit(ccn_interest *interest){
     return decision;
 
 }
-int spr::nearest(vector<int>& repositories){
+int spr::nearest(const repo_view& repositories){
 	#ifdef SEVERE_DEBUG
 	if (repositories.size()==0)
 		severe_error(__FILE__,__LINE__, "repositories has 0 elements");
@@ -82,7 +82,7 @@ int spr::nearest(vector<int>& repositories){
     int  min_len = 10000;
     vector<int> targets;
 
-    for (vector<int>::iterator i = repositories.begin(); i!=repositories.end();i++) 	{ 	//Find the shortest (the minimum)
+    for (repo_view::const_iterator i = repositories.begin(); i!=repositories.end();i++) 	{ 	//Find the shortest (the minimum)
     	//<aa>
     	const int_f FIB_entry = get_FIB_entry(*i);
     	//</aa>
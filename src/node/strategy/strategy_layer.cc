@@ -26,6 +26,7 @@
 #include "strategy_layer.h"
 #include <sstream>
 #include "error_handling.h"
+#include "memory_footprint.h" //<aa>
 ifstream strategy_layer::fdist;
 ifstream strategy_layer::frouting;
 
@@ -167,6 +168,15 @@ void strategy_layer::add_FIB_entry(
 	#endif
 }
 
+//<aa>
+size_t strategy_layer::fib_footprint(){
+	size_t bytes = footprint(FIB) + footprint(gatelu);
+	for (unordered_map<int, vector<int_f> >::iterator it = FIB.begin(); it != FIB.end(); ++it)
+		bytes += footprint(it->second);
+	return bytes;
+}
+//</aa>
+
 const vector<int_f> strategy_layer::get_FIB_entries(
 		int destination_node_index)
 {
@@ -0,0 +1,161 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <algorithm>
+#include "ccnsim.h"
+#include "content_sketch.h"
+#include "error_handling.h"
+#include "memory_footprint.h"
+
+content_sketch::content_sketch(unsigned width_, unsigned depth_, unsigned top_)
+	:depth(depth_),top_size(top_)
+{
+	// INPUT_CHECK{
+	if (width_ == 0 || depth == 0 || width_ > (1u<<30) ){
+		std::stringstream ermsg; 
+		ermsg<<"Invalid sketch: width="<<width_<<"; depth="<<depth;
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	// }INPUT_CHECK
+
+	unsigned bits = 0;
+	while ( (1u << bits) < width_)
+		bits++;
+	width = 1u << bits;
+	shift = 64 - bits;
+
+	//Odd multipliers drawn with splitmix64: the hashes do not depend on the
+	//simulation RNGs
+	uint64_t x = 0x9E3779B97F4A7C15ULL;
+	for (unsigned r = 0; r < depth; r++){
+		uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30) ) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27) ) * 0x94D049BB133111EBULL;
+		seeds.push_back( (z ^ (z >> 31) ) | 1);
+	}
+
+	hit_counters.assign(depth * width, 0);
+	miss_counters.assign(depth * width, 0);
+	heap.reserve(top_size);
+}
+
+void content_sketch::clear(){
+	fill(hit_counters.begin(), hit_counters.end(), 0);
+	fill(miss_counters.begin(), miss_counters.end(), 0);
+	heap.clear();
+	position.clear();
+}
+
+uint32_t content_sketch::estimate(const vector<uint32_t> &counters, name_t name) const{
+	uint32_t m = counters[ column(0, name) ];
+	for (unsigned r = 1; r < depth; r++)
+		m = min(m, counters[r * width + column(r, name)]);
+	return m;
+}
+
+//Conservative update: only the counters equal to the current estimate grow
+void content_sketch::update(vector<uint32_t> &counters, name_t name){
+	uint32_t m = estimate(counters, name);
+	for (unsigned r = 0; r < depth; r++){
+		uint32_t &c = counters[r * width + column(r, name)];
+		if (c == m)
+			c++;
+	}
+}
+
+void content_sketch::record(name_t name, bool hit){
+	update(hit ? hit_counters : miss_counters, name);
+
+	if (top_size == 0)
+		return;
+
+	boost::unordered_map<name_t, unsigned>::iterator it = position.find(name);
+	unsigned i;
+	if (it != position.end() )
+		i = it->second;
+	else if (heap.size() < top_size){
+		sketch_top_entry e = {name, 0, 0, 0};
+		i = heap.size();
+		heap.push_back(e);
+		position[name] = i;
+	} else {
+		//The content replaces the least requested one, inheriting its count
+		position.erase(heap[0].name);
+		heap[0].name = name;
+		heap[0].error = heap[0].count;
+		heap[0].hits = 0;
+		position[name] = 0;
+		i = 0;
+	}
+
+	heap[i].count++;
+	if (hit)
+		heap[i].hits++;
+	sift_down(i);
+
+	//A new entry, with count 1, may be smaller than its parents
+	while (i > 0 && heap[i].count < heap[(i-1)/2].count){
+		swap_entries(i, (i-1)/2);
+		i = (i-1)/2;
+	}
+}
+
+void content_sketch::swap_entries(unsigned i, unsigned j){
+	swap(heap[i], heap[j]);
+	position[ heap[i].name ] = i;
+	position[ heap[j].name ] = j;
+}
+
+void content_sketch::sift_down(unsigned i){
+	while (1){
+		unsigned smallest = i;
+		unsigned l = 2*i + 1, r = 2*i + 2;
+		if (l < heap.size() && heap[l].count < heap[smallest].count)
+			smallest = l;
+		if (r < heap.size() && heap[r].count < heap[smallest].count)
+			smallest = r;
+		if (smallest == i)
+			return;
+		swap_entries(i, smallest);
+		i = smallest;
+	}
+}
+
+size_t content_sketch::memory_footprint() const{
+	return footprint(seeds) + footprint(hit_counters) + footprint(miss_counters) +
+		footprint(heap) + footprint(position);
+}
+
+static bool more_requested(const sketch_top_entry &a, const sketch_top_entry &b){
+	return a.count > b.count;
+}
+
+vector<sketch_top_entry> content_sketch::top() const{
+	vector<sketch_top_entry> sorted(heap);
+	sort(sorted.begin(), sorted.end(), more_requested);
+	return sorted;
+}
+//</aa>
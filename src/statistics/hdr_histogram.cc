@@ -0,0 +1,64 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <cstring>
+#include "hdr_histogram.h"
+
+void hdr_histogram::clear(){
+	memset(counts, 0, sizeof(counts) );
+	total = 0;
+}
+
+void hdr_histogram::merge(const hdr_histogram &other){
+	for (unsigned i = 0; i < HDR_BUCKETS; i++)
+		counts[i] += other.counts[i];
+	total += other.total;
+}
+
+double hdr_histogram::quantile(double q) const{
+	if (total == 0)
+		return 0;
+
+	uint64_t rank = (uint64_t) (q * total);
+	if (rank >= total)
+		rank = total - 1;
+
+	uint64_t seen = 0;
+	unsigned i = 0;
+	for (; i < HDR_BUCKETS - 1; i++){
+		seen += counts[i];
+		if (seen > rank)
+			break;
+	}
+
+	//Middle of the bucket [m << shift, (m+1) << shift)
+	unsigned half = 1 << (HDR_SUB_BITS - 1);
+	unsigned shift = i < 2 * half ? 0 : i / half - 1;
+	uint64_t m = i < 2 * half ? i : i % half + half;
+	double value = ( (m << shift) + ( ( (uint64_t) 1 << shift) - 1) / 2.);
+	return value / HDR_UNITS_PER_SECOND;
+}
+//</aa>
@@ -0,0 +1,107 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <sys/time.h>
+#include "profiler.h"
+
+//Nodes listed for each section in the report
+#define PROFILE_TOP_NODES 5
+
+vector<profile_entry> profiler::entries[PROFILE_SECTIONS];
+
+static const char *section_names[PROFILE_SECTIONS] = {
+	"core_layer", "client", "statistics", "get_decision", "lookup", "store"
+};
+
+struct profile_line{
+	int node;
+	profile_entry entry;
+	bool operator<(const profile_line &other) const { return entry.cycles > other.entry.cycles; }
+};
+
+static double wall_time(){
+	struct timeval t;
+	gettimeofday(&t, NULL);
+	return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//Ticks per second, measured over a short busy wait
+static double tick_rate(){
+	double w0 = wall_time(), w1;
+	uint64_t t0 = profiler::ticks();
+	do
+		w1 = wall_time();
+	while (w1 - w0 < 0.01);
+	return (profiler::ticks() - t0) / (w1 - w0);
+}
+
+void profiler::report(){
+	double rate = tick_rate();
+
+	vector<profile_line> sections;
+	for (unsigned s = 0; s < PROFILE_SECTIONS; s++){
+		profile_line line;
+		line.node = s;
+		for (unsigned n = 0; n < entries[s].size(); n++){
+			line.entry.events += entries[s][n].events;
+			line.entry.cycles += entries[s][n].cycles;
+		}
+		if (line.entry.events > 0)
+			sections.push_back(line);
+	}
+	sort(sections.begin(), sections.end() );
+
+	cout<<endl<<"Profile (cycles include the nested sections):"<<endl;
+	cout<<setw(14)<<"section"<<setw(14)<<"events"<<setw(18)<<"cycles"<<
+		setw(12)<<"seconds"<<setw(14)<<"cycles/event"<<endl;
+	for (unsigned i = 0; i < sections.size(); i++){
+		const profile_entry &e = sections[i].entry;
+		cout<<setw(14)<<section_names[ sections[i].node ]<<setw(14)<<e.events<<setw(18)<<e.cycles<<
+			setw(12)<<e.cycles / rate<<setw(14)<<e.cycles / e.events<<endl;
+
+		vector<profile_line> nodes;
+		for (unsigned n = 0; n < entries[ sections[i].node ].size(); n++){
+			profile_line line;
+			line.node = n;
+			line.entry = entries[ sections[i].node ][n];
+			if (line.entry.events > 0)
+				nodes.push_back(line);
+		}
+		sort(nodes.begin(), nodes.end() );
+		for (unsigned n = 0; n < nodes.size() && n < PROFILE_TOP_NODES; n++){
+			std::ostringstream label;
+			label<<"node["<<nodes[n].node<<"]";
+			const profile_entry &ne = nodes[n].entry;
+			cout<<setw(14)<<label.str()<<setw(14)<<ne.events<<setw(18)<<ne.cycles<<
+				setw(12)<<ne.cycles / rate<<setw(14)<<ne.cycles / ne.events<<endl;
+		}
+	}
+}
+//</aa>
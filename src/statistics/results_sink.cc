@@ -0,0 +1,163 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "results_sink.h"
+#include "error_handling.h"
+
+results_sink *results_sink::sink = NULL;
+
+
+void results_sink::open(const string &path){
+	if (sink != NULL){
+		std::stringstream ermsg; 
+		ermsg<<"The results file "<<sink->path<<" is already open";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	sink = new results_sink(path);
+}
+
+void results_sink::close(){
+	if (sink == NULL)
+		return;
+	sink->write();
+	delete sink;
+	sink = NULL;
+}
+
+void results_sink::add(int node, uint32_t file, const char *metric, double value){
+	uint16_t id;
+	//The rows of a metric usually come in a row: avoid the lookup
+	if (!sink->metrics.empty() && sink->metric_names[ sink->metrics.back() ].compare(metric) == 0)
+		id = sink->metrics.back();
+	else {
+		map<string, uint16_t>::iterator it = sink->metric_ids.find(metric);
+		if (it == sink->metric_ids.end() ){
+			id = sink->metric_names.size();
+			sink->metric_ids[metric] = id;
+			sink->metric_names.push_back(metric);
+		} else
+			id = it->second;
+	}
+
+	sink->nodes.push_back(node);
+	sink->files.push_back(file);
+	sink->metrics.push_back(id);
+	sink->values.push_back(value);
+}
+
+//Orders the rows by metric, keeping the order in which they were added
+struct by_metric{
+	const vector<uint16_t> &metrics;
+	by_metric(const vector<uint16_t> &m):metrics(m){;}
+	bool operator()(uint64_t a, uint64_t b) const { return metrics[a] < metrics[b]; }
+};
+
+template <class T>
+static void write_column(FILE *out, const vector<T> &column, const vector<uint64_t> &order){
+	vector<T> sorted(order.size() );
+	for (uint64_t r = 0; r < order.size(); r++)
+		sorted[r] = column[ order[r] ];
+	if (!sorted.empty() )
+		fwrite(&sorted[0], sizeof(T), sorted.size(), out);
+}
+
+void results_sink::write(){
+	FILE *out = fopen(path.c_str(), "wb");
+	if (out == NULL){
+		std::stringstream ermsg; 
+		ermsg<<"Impossible to write the results file "<<path;
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	uint64_t rows = values.size();
+	vector<uint64_t> order(rows);
+	for (uint64_t r = 0; r < rows; r++)
+		order[r] = r;
+	stable_sort(order.begin(), order.end(), by_metric(metrics) );
+
+	results_header header;
+	memcpy(header.magic, RESULTS_MAGIC, sizeof(header.magic) );
+	header.version = RESULTS_VERSION;
+	header.metrics = metric_names.size();
+	header.rows = rows;
+
+	//Metric table
+	vector<uint64_t> first(metric_names.size(), 0), count(metric_names.size(), 0);
+	for (uint64_t r = 0; r < rows; r++)
+		count[ metrics[r] ]++;
+	uint64_t table_size = 0;
+	for (unsigned m = 0; m < metric_names.size(); m++){
+		first[m] = m == 0 ? 0 : first[m-1] + count[m-1];
+		table_size += sizeof(results_metric) + metric_names[m].size();
+	}
+
+	header.node_offset = sizeof(results_header) + table_size;
+	header.file_offset = header.node_offset + rows * sizeof(int32_t);
+	header.metric_offset = header.file_offset + rows * sizeof(uint32_t);
+	header.value_offset = header.metric_offset + rows * sizeof(uint16_t);
+
+	fwrite(&header, sizeof(header), 1, out);
+	for (unsigned m = 0; m < metric_names.size(); m++){
+		results_metric entry;
+		entry.first_row = first[m];
+		entry.rows = count[m];
+		entry.name_len = metric_names[m].size();
+		fwrite(&entry, sizeof(entry), 1, out);
+		fwrite(metric_names[m].data(), 1, entry.name_len, out);
+	}
+
+	write_column(out, nodes, order);
+	write_column(out, files, order);
+	write_column(out, metrics, order);
+	write_column(out, values, order);
+
+	if (fclose(out) != 0){
+		std::stringstream ermsg; 
+		ermsg<<"Error while writing the results file "<<path;
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	cout<<rows<<" results written to "<<path<<endl;
+}
+
+
+void record_result(cComponent *module, const char *metric, int node, double value){
+	if (results_sink::enabled() ){
+		results_sink::add(node, 0, metric, value);
+		if (node >= 0)
+			return;
+	}
+
+	if (node >= 0){
+		char name[64];
+		sprintf ( name, "%s[%d]", metric, node);
+		module->recordScalar(name, value);
+	} else
+		module->recordScalar(metric, value);
+}
+//</aa>
@@ -0,0 +1,100 @@
+/*
+ * ccnSim is a scalable chunk-level simulator for Content Centric
+ * Networks (CCN), that we developed in the context of ANR Connect
+ * (http://www.anr-connect.org/)
+ *
+ * People:
+ *    Giuseppe Rossini (lead developer, mailto giuseppe.rossini@enst.fr)
+ *    Andrea Araldo (developer, mailto andrea.araldo@gmail.com)
+ *    Raffaele Chiocchetti (developer, mailto raffaele.chiocchetti@gmail.com)
+ *    Dario Rossi (occasional debugger, mailto dario.rossi@enst.fr)
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//<aa>
+#include <cmath>
+#include <sstream>
+#include "stability_detector.h"
+#include "error_handling.h"
+
+stability_detector *stability_detector::create(const string &type, unsigned window_samples, double threshold){
+	if (window_samples == 0)
+		window_samples = 1;
+
+	if (type.compare("welford") == 0)
+		return new welford_detector(window_samples, threshold);
+	else if (type.compare("sliding") == 0)
+		return new sliding_detector(window_samples, threshold);
+	else if (type.compare("ewma") == 0)
+		return new ewma_detector(window_samples, threshold);
+
+	std::stringstream ermsg; 
+	ermsg<<"Stability detector \""<<type<<"\" incorrect. Valid detectors are welford, sliding and ewma";
+	severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	return NULL;
+}
+
+bool welford_detector::add(double sample){
+	n++;
+	double delta = sample - mean;
+	mean += delta / n;
+	m2 += delta * (sample - mean);
+
+	if (n < window_samples)
+		return false;
+
+	//End of the window: population standard deviation of its samples
+	bool stable = sqrt(m2 / n) <= threshold;
+	n = 0;
+	mean = m2 = 0;
+	return stable;
+}
+
+bool sliding_detector::add(double sample){
+	if (n < window_samples){
+		ring[n++] = sample;
+		double delta = sample - mean;
+		mean += delta / n;
+		m2 += delta * (sample - mean);
+		if (n < window_samples)
+			return false;
+	} else {
+		//Replace the oldest sample with the new one
+		double old = ring[next];
+		ring[next] = sample;
+		next = (next + 1) % window_samples;
+
+		double old_mean = mean;
+		mean += (sample - old) / n;
+		m2 += (sample - old) * (sample - mean + old - old_mean);
+		if (m2 < 0)
+			m2 = 0; //Rounding errors
+	}
+	return sqrt(m2 / n) <= threshold;
+}
+
+bool ewma_detector::add(double sample){
+	double alpha = 1. / window_samples;
+	if (n++ == 0){
+		mean = sample;
+		return false;
+	}
+	double delta = sample - mean;
+	mean += alpha * delta;
+	var = (1 - alpha) * (var + alpha * delta * delta);
+
+	return n >= window_samples && sqrt(var) <= threshold;
+}
+//</aa>
@@ -25,17 +25,43 @@
 #include <cmath>
 #include "statistics.h"
 #include "core_layer.h"
+#include "strategy_layer.h" //<aa>
 #include "base_cache.h"
 #include "content_distribution.h"
 #include "lru_cache.h"
 
 //<aa>
 #include "error_handling.h"
+#include "results_sink.h"
+#include "profiler.h"
+#include <iomanip>
+#include <sys/time.h>
+#include <unistd.h>
 //</aa>
 
 
 Register_Class(statistics);
 
+//<aa>
+static double wall_clock(){
+	struct timeval t;
+	gettimeofday(&t, NULL);
+	return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//Resident memory of the process, from /proc/self/statm (0 where unavailable)
+static double rss_MB(){
+	long pages = 0, resident = 0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm != NULL){
+		if (fscanf(statm, "%ld %ld", &pages, &resident) != 2)
+			resident = 0;
+		fclose(statm);
+	}
+	return resident * (double) sysconf(_SC_PAGESIZE) / 1048576.;
+}
+//</aa>
+
 
 using namespace std;
 
@@ -52,6 +78,38 @@ void statistics::initialize(){
     partial_n 	= par("partial_n");
 	//<aa>
 	variance_threshold = par("variance_threshold");
+	link_capacity = par("link_capacity");
+	last_clear = 0;
+
+	//The other modules finish after statistics: the results file is written
+	//when statistics is deleted
+	string results_file = par("results_file").stdstringValue();
+	if (results_file.size() > 0)
+		results_sink::open(results_file);
+
+	string termination = par("termination").stdstringValue();
+	batch_time = par("batch_time");
+	min_batches = (unsigned) par("min_batches").longValue();
+	ci_target = par("ci_target");
+
+	// INPUT_CHECK{
+	if (termination.compare("steady") == 0)
+		batch_means = false;
+	else if (termination.compare("batch_means") == 0)
+		batch_means = true;
+	else {
+		std::stringstream ermsg; 
+		ermsg<<"termination \""<<termination<<"\" incorrect. Valid values are steady and batch_means";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+
+	if (batch_means && (batch_time <= 0 || min_batches < 2 || ci_target <= 0) ){
+		std::stringstream ermsg; 
+		ermsg<<"batch_time="<<batch_time<<"; min_batches="<<min_batches<<"; ci_target="<<
+			ci_target<<". batch_time and ci_target must be positive and min_batches at least 2";
+		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+	}
+	// }INPUT_CHECK
 	//</aa>
 
     if (partial_n == -1)
@@ -62,6 +120,7 @@ void statistics::initialize(){
     //Extracting clients
     clients = new client* [num_clients];
     vector<string> clients_vec(1,"modules.clients.client");
+	clients_vec.push_back("modules.clients.population_client"); //<aa>
     topo.extractByNedTypeName(clients_vec);
     int k = 0;
     for (int i = 0;i<topo.getNumNodes();i++){
@@ -122,41 +181,84 @@ void statistics::initialize(){
 		cores [i] = (core_layer *) (topo.getNode(i)->getModule()->getModuleByRelativePath("core_layer"));
     }
 
+	init_levels(); //<aa>
+
     //Store samples for stabilization
-    samples.resize(num_nodes);
+	//<aa> It was samples.resize(num_nodes) </aa>
+	string detector_type = par("stability_detector").stdstringValue();
+	unsigned window_samples = (unsigned) floor(window / ts + 0.5);
+	for (int i = 0; i < num_nodes; i++)
+		detectors.push_back( stability_detector::create(detector_type, window_samples, variance_threshold) );
 
     full_check = new cMessage("full_check", FULL_CHECK);
     stable_check = new cMessage("stable_check",STABLE_CHECK);
     end = new cMessage("end",END);
+	batch_check = new cMessage("batch_check", BATCH_CHECK); //<aa>
+
+	//<aa>
+	phase = "filling";
+	telemetry = NULL;
+	string telemetry_path = par("telemetry_file").stdstringValue();
+	telemetry_period = par("telemetry_period");
+	if (telemetry_path.size() > 0){
+		telemetry_file.open(telemetry_path.c_str(), ios::out | ios::app);
+		if (!telemetry_file){
+			std::stringstream ermsg; 
+			ermsg<<"Impossible to open the telemetry file "<<telemetry_path;
+			severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
+		}
+	}
+	// The tick adds events to the simulation: schedule it only when there
+	// is an open file to write to
+	if (telemetry_file.is_open() ){
+		telemetry_file<<"# wall_time sim_time events events_per_s sim_per_wall phase p_hit rss_MB"<<endl;
+		last_wall = wall_clock();
+		last_sim = simTime().dbl();
+		last_events = simulation.getEventNumber();
+		telemetry = new cMessage("telemetry", TELEMETRY);
+		scheduleAt(simTime() + ts, telemetry);
+	}
+	//</aa>
 
 	cout<<endl;
 
-    //Start checking for full
-    scheduleAt(simTime() + ts, full_check);
+	//<aa> Caches are no more polled: each of them calls cache_full() when it
+	// gets full. full_check is fired as soon as partial_n caches are full or,
+	// at most, after 10 hours (as the polling did) </aa>
+	full_caches = 0;
+	if (partial_n <= 0)
+		scheduleAt(simTime() + ts, full_check);
+	else
+		scheduleAt(max(simTime(), simtime_t(10*3600) ), full_check);
     
 }
 
 
 
+//<aa>
+statistics::~statistics(){
+	results_sink::close();
+}
+//</aa>
+
 void statistics::handleMessage(cMessage *in){
+	PROFILE_SCOPE(PROFILE_STATISTICS, 0); //<aa>
     //Handle simulation timers
 
-    int full = 0;
     int stables = 0;
 
     switch (in->getKind()){
         case FULL_CHECK:
-            for (int i = 0; i < num_nodes;i++)
-        	full += (int)caches[i]->full();
-
-            if (full >= partial_n || simTime()>=10*3600){
+        	//<aa> It was a periodic check of caches[i]->full(). See cache_full() </aa>
         	cout<<"Caches filled at time "<<simTime()<<endl;
+        	//<aa>
+        	recordScalar("fill_time", simTime() );
+        	//</aa>
         	clear_stat();
         	scheduleAt(simTime() + ts, stable_check);
+        	phase = "stabilising"; //<aa>
         	delete full_check;
-            }else
-        	scheduleAt(simTime() + ts, in);
-
+        	full_check = NULL; //<aa>
             break;
 
         case STABLE_CHECK:
@@ -172,8 +274,44 @@ void statistics::handleMessage(cMessage *in){
             } else 
         		scheduleAt(simTime() + ts, in);
 		    break;
+        //<aa>
+        case TELEMETRY:
+            if (wall_clock() - last_wall >= telemetry_period)
+                write_telemetry();
+            // Stop ticking if the file can no longer be written
+            if (!telemetry_file){
+                delete in;
+                telemetry = NULL;
+            } else
+                scheduleAt(simTime() + ts, in);
+            break;
+        case LEVEL_SAMPLE:
+            sample_levels();
+            scheduleAt(simTime() + level_sampling, in);
+            break;
+        case BATCH_CHECK:
+            if ( batch_means_converged() ){
+                cancelEvent(end);
+                scheduleAt(simTime(), end);
+            } else
+                scheduleAt(simTime() + batch_time, in);
+            break;
+        //</aa>
         case END:
             delete in;
+            cancelAndDelete(batch_check); //<aa>
+            batch_check = NULL; //<aa>
+            //<aa>
+            if (telemetry != NULL){
+                write_telemetry();
+                cancelAndDelete(telemetry);
+                telemetry = NULL;
+            }
+            if (level_sample != NULL){
+                cancelAndDelete(level_sample);
+                level_sample = NULL;
+            }
+            //</aa>
             endSimulation();
     }
 
@@ -182,25 +320,14 @@ void statistics::handleMessage(cMessage *in){
 bool statistics::stable(int n){
 
     bool stable = false;
-    double var = 0.0;
     double rate = caches[n]->hit * 1./ ( caches[n]->hit + caches[n]->miss );
 
     //Only hit rates matter, not also the misses
-    if (caches[n]->hit != 0 ){
-        samples[n].push_back( rate );
-    }else 
-        samples[n].push_back(0);
-
-    if ( fabs( samples[n].size() - window * 1./ts ) <= 0.001 )
-	{ //variance each window seconds
-		var =variance(samples[n]); 
-        // cout<<n<<"] variance = "<<var<<endl; //<aa> I disabled this line </aa>
-        if ( var <= variance_threshold){
-            stabilization_time = simTime().dbl();
-            stable = true;
-        }
-        samples[n].clear();
-
+	//<aa> The samples used to be stored and their variance computed every 
+	// window seconds. The detector updates its statistics in O(1) </aa>
+    if ( detectors[n]->add(caches[n]->hit != 0 ? rate : 0) ){
+        stabilization_time = simTime().dbl();
+        stable = true;
     }
     return stable;
 
@@ -209,8 +336,6 @@ bool statistics::stable(int n){
 
 void statistics::finish(){
 
-    char name[30];
-
     uint32_t global_hit = 0;
     uint32_t global_miss = 0;
     uint32_t global_interests = 0;
@@ -225,6 +350,11 @@ void statistics::finish(){
     simtime_t global_avg_time = 0;
     uint32_t global_tot_downloads = 0;
 
+	//<aa>
+	hdr_histogram global_chunk_rtt;
+	hdr_histogram global_completion;
+	//</aa>
+
     //<aa>
     #ifdef SEVERE_DEBUG
     unsigned int global_interests_sent = 0;
@@ -268,21 +398,21 @@ void statistics::finish(){
     //Print and store global statistics
 
     //global_hit is the sum of the hits of each cache
-    sprintf (name, "p_hit");
-    recordScalar(name,global_hit * 1./(global_hit+global_miss));
+    record_result(this, "p_hit", -1, global_hit * 1./(global_hit+global_miss));
     cout<<"p_hit/cache: "<<global_hit *1./(global_hit+global_miss)<<endl;
 
-    sprintf ( name, "interests");
-    recordScalar(name,global_interests * 1./num_nodes);
+    record_result(this, "interests", -1, global_interests * 1./num_nodes);
 
-    sprintf ( name, "data" );
-    recordScalar(name,global_data * 1./num_nodes);
+    record_result(this, "data", -1, global_data * 1./num_nodes);
 
     for (int i = 0;i<num_clients;i++){
 		global_avg_distance += clients[i]->get_avg_distance();
 		global_tot_downloads += clients[i]->get_tot_downloads();
 		global_avg_time  += clients[i]->get_avg_time();
 		//<aa>
+		global_chunk_rtt.merge( clients[i]->get_chunk_rtt_histogram() );
+		global_completion.merge( clients[i]->get_completion_histogram() );
+
 		#ifdef SEVERE_DEBUG
 		global_interests_sent += clients[i]->get_interests_sent();
 		#endif
@@ -290,33 +420,33 @@ void statistics::finish(){
 
     }
 
-    sprintf ( name, "hdistance");
-    recordScalar(name,global_avg_distance * 1./num_clients);
+    record_result(this, "hdistance", -1, global_avg_distance * 1./num_clients);
     cout<<"Distance/client: "<<global_avg_distance * 1./num_clients<<endl;
 
-    sprintf ( name, "avg_time");
-    recordScalar(name,global_avg_time * 1./num_clients);
+    record_result(this, "avg_time", -1, global_avg_time.dbl() / num_clients);
     cout<<"Time/client: "<<global_avg_time * 1./num_clients<<endl;
 
+	//<aa>
+	record_quantiles("chunk_rtt", global_chunk_rtt);
+	record_quantiles("completion_time", global_completion);
+	cout<<"P99 completion time: "<<global_completion.quantile(0.99)<<endl;
+	//</aa>
+
 
 	//<aa> Sum of the download of all users//</aa>
-    sprintf ( name, "downloads");
-    recordScalar(name,global_tot_downloads);
+    record_result(this, "downloads", -1, global_tot_downloads);
 
-    sprintf ( name, "total_cost");
-    recordScalar(name,total_cost);
+    record_result(this, "total_cost", -1, total_cost);
     cout<<"total_cost: "<<total_cost<<endl;
 
 
-    sprintf ( name, "total_replicas");
-    recordScalar(name,total_replicas);
+    record_result(this, "total_replicas", -1, total_replicas);
     cout<<"total_replicas: "<<total_replicas<<endl;
 
     //<aa>
     // It is the fraction of traffic that is satisfied by some cache inside
     // the network and thus does not exit the network </aa>
-    sprintf (name, "inner_hit");
-    recordScalar(name , (double) (global_tot_downloads - global_repo_load) / global_tot_downloads) ;
+    record_result(this, "inner_hit", -1, (double) (global_tot_downloads - global_repo_load) / global_tot_downloads) ;
 
     #ifdef SEVERE_DEBUG
 	if (global_tot_downloads == 0)
@@ -326,8 +456,7 @@ void statistics::finish(){
 		severe_error(__FILE__,__LINE__,ermsg.str().c_str() );
 	}
 
-		sprintf ( name, "interests_sent");
-		recordScalar(name,global_interests_sent);
+		record_result(this, "interests_sent", -1, global_interests_sent);
 		cout<<"interests_sent: "<<global_interests_sent<<endl;
 
 		if (global_interests_sent != global_tot_downloads){
@@ -350,10 +479,38 @@ void statistics::finish(){
     //         hit_rate = hit_per_file[f] / ( hit_per_file[f] +miss_per_file[f] );
     //     hit_per_fileV.recordWithTimestamp(f, hit_rate);
     //}
+
+	//<aa> Precision achieved on the steady state estimates
+	if (batch_means){
+		record_result(this, "batches", -1, hit_batches.n);
+		if (hit_batches.n >= 2){
+			record_result(this, "p_hit_ci", -1, hit_batches.relative_half_width());
+			record_result(this, "hdistance_ci", -1, distance_batches.relative_half_width());
+			cout<<"Relative 95% CI half width: p_hit "<<hit_batches.relative_half_width()<<
+				", hdistance "<<distance_batches.relative_half_width()<<endl;
+		}
+	}
+	//</aa>
+
+	//<aa>
+	record_levels();
+	record_link_load();
+	record_memory("end");
+
+	#ifdef PROFILER
+	profiler::report();
+	#endif
+
+	for (unsigned i = 0; i < detectors.size(); i++)
+		delete detectors[i];
+	detectors.clear();
+	//</aa>
 }
 
 void statistics::clear_stat()
 {
+    last_clear = simTime().dbl(); //<aa>
+
     for (int i = 0;i<num_clients;i++)
 	if (clients[i]->is_active() )
 	    clients[i]->clear_stat();
@@ -363,6 +520,10 @@ void statistics::clear_stat()
 
     for (int i = 0;i<num_nodes;i++)
 	    caches[i]->clear_stat();
+
+	//<aa> The next level sample starts from the cleared counters </aa>
+	if (level_sampling > 0)
+		last_levels.assign(levels, level_counters() );
 }
 
 void statistics::stability_has_been_reached(){
@@ -371,9 +532,310 @@ void statistics::stability_has_been_reached(){
 	sprintf (name, "stabilization_time");
 	recordScalar(name,stabilization_time);
 	cout<<"stabilization_time: "<< stabilization_time <<endl;
+
+	record_memory("stable");
+	phase = "steady";
 	//</aa>
 
 	clear_stat();
+
+	//<aa> The batches start from the statistics just cleared
+	if (batch_means){
+		last_hits = last_requests = last_hops = last_chunks = 0;
+		scheduleAt(simTime() + batch_time, batch_check);
+	}
+	//</aa>
+}
+
+//<aa> Batch means [batch]: the steady state is cut into batches of batch_time
+// seconds. The means of the hit ratio and of the hop distance over each batch
+// are considered as independent samples, on which a confidence interval is
+// computed. The batches are made from the differences of the cumulative
+// counters of the caches and of the clients, so nothing is cleared.
+bool statistics::batch_means_converged(){
+	double hits = 0, requests = 0, hops = 0, chunks = 0;
+	for (int i = 0; i < num_nodes; i++){
+		hits += caches[i]->hit;
+		requests += caches[i]->hit + caches[i]->miss;
+	}
+	for (int i = 0; i < num_clients; i++){
+		hops += clients[i]->get_avg_distance() * clients[i]->get_tot_chunks();
+		chunks += clients[i]->get_tot_chunks();
+	}
+
+	//An empty batch carries no sample
+	if (requests > last_requests && chunks > last_chunks){
+		hit_batches.add( (hits - last_hits) / (requests - last_requests) );
+		distance_batches.add( (hops - last_hops) / (chunks - last_chunks) );
+	}
+	last_hits = hits; last_requests = requests;
+	last_hops = hops; last_chunks = chunks;
+
+	if (hit_batches.n < min_batches)
+		return false;
+	return hit_batches.relative_half_width() <= ci_target &&
+		distance_batches.relative_half_width() <= ci_target;
+}
+
+//<aa> The level of a node is its level parameter or, when it is not given
+// (-1), its distance in hops from the closest repository. In the tree 
+// networks, the root holds the repository and the level is the depth </aa>
+void statistics::init_levels(){
+	cTopology topo;
+	vector<string> nodes_vec(1,"modules.node.node");
+	topo.extractByNedTypeName(nodes_vec);
+
+	node_level.assign(num_nodes, -1);
+	vector<double> distance(num_nodes, INFINITY);
+	int num_repos = getAncestorPar("num_repos");
+	for (int r = 0; r < num_repos; r++){
+		cTopology::Node *repo = NULL;
+		for (int i = 0; i < topo.getNumNodes(); i++)
+			if (topo.getNode(i)->getModule()->getIndex() == content_distribution::repositories[r])
+				repo = topo.getNode(i);
+		if (repo == NULL)
+			continue;
+		topo.calculateUnweightedSingleShortestPathsTo(repo);
+		for (int i = 0; i < num_nodes; i++)
+			distance[i] = min(distance[i], topo.getNode(i)->getDistanceToTarget() );
+	}
+
+	//The nodes are initialized after statistics: their level is read from the
+	//parameter, not from base_cache::level
+	levels = 0;
+	for (int i = 0; i < num_nodes; i++){
+		int level = caches[i]->getAncestorPar("level");
+		node_level[i] = level >= 0 ? level : 
+			(distance[i] != INFINITY ? (int) distance[i] : 0);
+		levels = max(levels, node_level[i] + 1);
+	}
+
+	level_sampling = par("level_sampling");
+	level_sample = NULL;
+	if (level_sampling > 0){
+		char name[30];
+		for (int l = 0; l < levels; l++){
+			sprintf (name, "level_p_hit[%d]", l);
+			level_hit_vectors.push_back(new cOutVector(name) );
+			sprintf (name, "level_forwarded[%d]", l);
+			level_forwarded_vectors.push_back(new cOutVector(name) );
+		}
+		last_levels.assign(levels, level_counters() );
+		level_sample = new cMessage("level_sample", LEVEL_SAMPLE);
+		scheduleAt(simTime() + level_sampling, level_sample);
+	}
+}
+
+vector<level_counters> statistics::collect_levels(){
+	vector<level_counters> counters(levels);
+	for (int i = 0; i < num_nodes; i++){
+		level_counters &c = counters[ node_level[i] ];
+		c.hits += caches[i]->hit;
+		c.misses += caches[i]->miss;
+		c.decision_yes += caches[i]->decision_yes;
+		c.decision_no += caches[i]->decision_no;
+		c.interests += cores[i]->interests;
+		for (unsigned f = 0; f < cores[i]->face_stats.size(); f++)
+			c.forwarded += cores[i]->face_stats[f].interests;
+	}
+	return counters;
+}
+
+void statistics::record_levels(){
+	vector<level_counters> counters = collect_levels();
+	vector<int> nodes(levels, 0);
+	for (int i = 0; i < num_nodes; i++)
+		nodes[ node_level[i] ]++;
+
+	//In the results file, the level is in the node column
+	for (int l = 0; l < levels; l++){
+		const level_counters &c = counters[l];
+		record_result(this, "level_nodes", l, nodes[l]);
+		record_result(this, "level_hits", l, c.hits);
+		record_result(this, "level_misses", l, c.misses);
+		record_result(this, "level_p_hit", l, c.hits + c.misses > 0 ? c.hits / (c.hits + c.misses) : 0);
+		record_result(this, "level_decision_yes", l, c.decision_yes);
+		record_result(this, "level_decision_no", l, c.decision_no);
+		record_result(this, "level_interests", l, c.interests);
+		record_result(this, "level_forwarded", l, c.forwarded);
+	}
+
+	for (unsigned l = 0; l < level_hit_vectors.size(); l++){
+		delete level_hit_vectors[l];
+		delete level_forwarded_vectors[l];
+	}
+	level_hit_vectors.clear();
+	level_forwarded_vectors.clear();
+}
+
+//Hit rate and forwarded interests (per second) of each level since the last
+//sample. The counters may have been cleared in the meanwhile: then they are
+//counted from the clearing
+void statistics::sample_levels(){
+	vector<level_counters> counters = collect_levels();
+	for (int l = 0; l < levels; l++){
+		level_counters &c = counters[l], &last = last_levels[l];
+		double hits = c.hits - last.hits;
+		double misses = c.misses - last.misses;
+		double forwarded = c.forwarded - last.forwarded;
+		if (hits + misses > 0)
+			level_hit_vectors[l]->record(hits / (hits + misses) );
+		level_forwarded_vectors[l]->record(forwarded / level_sampling);
+	}
+	last_levels = counters;
+}
+
+//<aa> Load of each registered link (i.e. direction of a connection between 
+// two nodes) since the last clear_stat, from the counters of the face its
+// channel starts from. The spread of the loads tells how evenly a forwarding
+// strategy uses the network </aa>
+//<aa> Result of the link from->to: in the results file, to is in the file
+// column </aa>
+static void record_link_result(cComponent *module, const char *metric, int from, int to, double value){
+	if (results_sink::enabled() ){
+		results_sink::add(from, to, metric, value);
+		return;
+	}
+	char name[40];
+	sprintf (name, "%s[%d-%d]", metric, from, to);
+	module->recordScalar(name, value);
+}
+
+void statistics::record_link_load(){
+	double duration = simTime().dbl() - last_clear;
+	if (icn_channels.empty() || duration <= 0)
+		return;
+
+	double max_load = 0, load_sum = 0, load_sum2 = 0;
+	double max_utilisation = 0, utilisation_sum = 0;
+	unsigned with_capacity = 0;
+	for (unsigned k = 0; k < icn_channels.size(); k++){
+		cGate *start = icn_channels[k]->getSourceGate()->getPathStartGate();
+		cGate *end = icn_channels[k]->getSourceGate()->getPathEndGate();
+		core_layer *from = (core_layer *) start->getOwnerModule();
+		int to = ( (abstract_node *) end->getOwnerModule() )->getIndex();
+		const face_counters &c = from->face_stats[ start->getIndex() ];
+
+		double load = c.bytes * 8. / duration; //bps
+		record_link_result(this, "link_interests", from->getIndex(), to, c.interests);
+		record_link_result(this, "link_data", from->getIndex(), to, c.data);
+		record_link_result(this, "link_load", from->getIndex(), to, load);
+
+		max_load = max(max_load, load);
+		load_sum += load;
+		load_sum2 += load * load;
+
+		double capacity = icn_channels[k]->getNominalDatarate();
+		if (capacity <= 0)
+			capacity = link_capacity;
+		if (capacity > 0){
+			max_utilisation = max(max_utilisation, load / capacity);
+			utilisation_sum += load / capacity;
+			with_capacity++;
+		}
+	}
+
+	unsigned links = icn_channels.size();
+	double mean = load_sum / links;
+	double variance = load_sum2 / links - mean * mean;
+	record_result(this, "link_load_max", -1, max_load);
+	record_result(this, "link_load_mean", -1, mean);
+	//Coefficient of variation: 0 when the load is evenly spread
+	record_result(this, "link_load_cv", -1, mean > 0 ? sqrt(variance > 0 ? variance : 0) / mean : 0);
+	if (with_capacity > 0){
+		record_result(this, "link_utilisation_max", -1, max_utilisation);
+		record_result(this, "link_utilisation_mean", -1, utilisation_sum / with_capacity);
+	}
+	cout<<"Link load: max "<<max_load<<" bps, mean "<<mean<<" bps"<<endl;
+}
+
+//<aa> Memory of the main structures, estimated from their sizes (see 
+// memory_footprint.h), as mem_<structure>_<phase> scalars in bytes. Summed
+// with the fixed costs of the modules, they predict the memory needed by a
+// given (objects, C, n) </aa>
+void statistics::record_memory(const char *phase){
+	size_t catalog = content_distribution::catalog_footprint();
+	size_t zipf = content_distribution::zipf.memory_footprint();
+	size_t cache_index = 0, pit = 0, fib = 0, perfile = 0;
+	for (int i = 0; i < num_nodes; i++){
+		cache_index += caches[i]->index_footprint();
+		perfile += caches[i]->stats_footprint();
+		pit += cores[i]->pit_footprint();
+		fib += cores[i]->strategy->fib_footprint();
+	}
+	for (int i = 0; i < num_clients; i++)
+		perfile += clients[i]->stats_footprint();
+	cache_index += content_index::memory_footprint(); //<aa> empty unless used by nrr </aa>
+
+	const char *structures[] = {"catalog", "zipf", "cache_index", "pit", "fib", "perfile", "total"};
+	size_t bytes[] = {catalog, zipf, cache_index, pit, fib, perfile,
+		catalog + zipf + cache_index + pit + fib + perfile};
+
+	cout<<"Memory ("<<phase<<"):";
+	char name[40];
+	for (unsigned s = 0; s < sizeof(bytes) / sizeof(bytes[0]); s++){
+		sprintf (name, "mem_%s_%s", structures[s], phase);
+		record_result(this, name, -1, bytes[s]);
+		cout<<" "<<structures[s]<<"="<<bytes[s] / 1048576.<<"MB";
+	}
+	cout<<endl;
+}
+
+void statistics::write_telemetry(){
+	double wall = wall_clock();
+	double sim = simTime().dbl();
+	int64_t events = simulation.getEventNumber();
+	double elapsed = wall - last_wall > 0 ? wall - last_wall : 1e-9;
+
+	double hits = 0, requests = 0;
+	for (int i = 0; i < num_nodes; i++){
+		hits += caches[i]->hit;
+		requests += caches[i]->hit + caches[i]->miss;
+	}
+
+	telemetry_file<<fixed<<setprecision(3)<<wall<<" "<<sim<<" "<<events<<" "<<
+		(events - last_events) / elapsed<<" "<<(sim - last_sim) / elapsed<<" "<<
+		phase<<" "<<(requests > 0 ? hits / requests : 0)<<" "<<rss_MB()<<endl;
+
+	last_wall = wall;
+	last_sim = sim;
+	last_events = events;
+}
+
+//Quantile 0.975 of the Student t distribution with df degrees of freedom
+static double student_t975(unsigned df){
+	static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365,
+		2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+		2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+	if (df <= 30)
+		return table[df - 1];
+	//Cornish-Fisher expansion around the normal quantile
+	double z = 1.959964;
+	return z + (z*z*z + z) / (4.*df) + (5*pow(z,5) + 16*z*z*z + 3*z) / (96.*df*df);
+}
+
+double batch_sums::relative_half_width() const {
+	if (n < 2)
+		return INFINITY;
+	double m = mean();
+	double variance = (sum2 - n*m*m) / (n - 1);
+	double half_width = student_t975(n - 1) * sqrt(variance > 0 ? variance : 0) / sqrt(n);
+	//With a zero mean, the interval is relative to nothing: only a null width is fine
+	if (m == 0)
+		return half_width == 0 ? 0 : INFINITY;
+	return half_width / fabs(m);
+}
+//</aa>
+
+void statistics::cache_full(){
+	Enter_Method_Silent();
+
+	full_caches++;
+	//The transition happens as soon as partial_n caches are full
+	if (full_check != NULL && full_caches >= partial_n){
+		cancelEvent(full_check);
+		scheduleAt(simTime(), full_check);
+	}
 }
 
 void statistics::registerIcnChannel(cChannel* icn_channel){
@@ -389,3 +851,19 @@ void statistics::registerIcnChannel(cChannel* icn_channel){
 	icn_channels.push_back(icn_channel);
 }
 //</aa>
+
+//<aa> Record the tail of the distribution of a metric
+void statistics::record_quantiles(const char *metric, const hdr_histogram &histogram){
+	const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+	const char *labels[] = {"p50", "p90", "p99", "p99.9"};
+	char name[40];
+
+	for (unsigned i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]); i++){
+		sprintf (name, "%s_%s", metric, labels[i]);
+		record_result(this, name, -1, histogram.quantile(quantiles[i]) );
+	}
+}
+//</aa>
+
+// References
+// [batch] A. M. Law, "Simulation Modeling and Analysis", 4th edition, McGraw-Hill, 2007, Section 9.5.3